@@ -0,0 +1,59 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "Vector3D.h"
+
+namespace Math {
+    // Axis-aligned box; empty (min > max) until a point is added
+    class BoundingBox {
+    public:
+        Vector3D min{ std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        Vector3D max{ std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+
+        constexpr BoundingBox() noexcept = default;
+        constexpr BoundingBox(const Vector3D& min, const Vector3D& max) noexcept : min(min), max(max) {}
+
+        [[nodiscard]] constexpr bool isEmpty() const noexcept {
+            return min.x > max.x || min.y > max.y || min.z > max.z;
+        }
+
+        constexpr void add(const Vector3D& p) noexcept {
+            min = Vector3D(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+            max = Vector3D(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+        }
+
+        constexpr void add(const BoundingBox& other) noexcept {
+            min = Vector3D(std::min(min.x, other.min.x), std::min(min.y, other.min.y), std::min(min.z, other.min.z));
+            max = Vector3D(std::max(max.x, other.max.x), std::max(max.y, other.max.y), std::max(max.z, other.max.z));
+        }
+
+        [[nodiscard]] constexpr Vector3D center() const noexcept {
+            return Vector3D((min.x + max.x) / 2.0f, (min.y + max.y) / 2.0f, (min.z + max.z) / 2.0f);
+        }
+
+        [[nodiscard]] constexpr Vector3D size() const noexcept {
+            return isEmpty() ? Vector3D() : max - min;
+        }
+
+        [[nodiscard]] constexpr float maxDimension() const noexcept {
+            const Vector3D s = size();
+            return std::max({ s.x, s.y, s.z });
+        }
+    };
+
+    class BoundingSphere {
+    public:
+        Vector3D center;
+        float radius = -1.0f; // Negative when empty
+
+        [[nodiscard]] constexpr bool isEmpty() const noexcept {
+            return radius < 0.0f;
+        }
+
+        // Distance from the origin to the farthest point the sphere can contain
+        [[nodiscard]] float reachFromOrigin() const noexcept {
+            return isEmpty() ? 0.0f : center.length() + radius;
+        }
+    };
+}
@@ -1,14 +1,20 @@
 #pragma once
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace Render {
-    class Edge {
+    // Edge storage is parameterized on index width; indices are always read back as std::size_t
+    template <typename Index>
+    class BasicEdge {
     private:
-        std::size_t vertexIndex1;
-        std::size_t vertexIndex2;
+        Index vertexIndex1;
+        Index vertexIndex2;
 
     public:
-        explicit Edge(std::size_t v1, std::size_t v2) noexcept : vertexIndex1(v1), vertexIndex2(v2) {}
+        using IndexType = Index;
+
+        explicit BasicEdge(Index v1, Index v2) noexcept : vertexIndex1(v1), vertexIndex2(v2) {}
 
         [[nodiscard]] std::size_t getVertex1Index() const noexcept {
             return vertexIndex1;
@@ -18,4 +24,12 @@ namespace Render {
             return vertexIndex2;
         }
     };
-}
\ No newline at end of file
+
+    // Widest storage type; a distinct 64-bit type even where std::size_t is 32-bit
+    using WideEdgeIndex = std::conditional_t<(sizeof(std::size_t) > sizeof(uint32_t)), std::size_t, uint64_t>;
+
+    using Edge = BasicEdge<std::size_t>;
+    using Edge16 = BasicEdge<uint16_t>;
+    using Edge32 = BasicEdge<uint32_t>;
+    using EdgeWide = BasicEdge<WideEdgeIndex>;
+}
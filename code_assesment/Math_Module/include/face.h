@@ -0,0 +1,27 @@
+#pragma once
+#include <cstddef>
+
+namespace Render {
+    class Face {
+    private:
+        std::size_t vertexIndex1;
+        std::size_t vertexIndex2;
+        std::size_t vertexIndex3;
+
+    public:
+        explicit Face(std::size_t v1, std::size_t v2, std::size_t v3) noexcept
+            : vertexIndex1(v1), vertexIndex2(v2), vertexIndex3(v3) {}
+
+        [[nodiscard]] std::size_t getVertex1Index() const noexcept {
+            return vertexIndex1;
+        }
+
+        [[nodiscard]] std::size_t getVertex2Index() const noexcept {
+            return vertexIndex2;
+        }
+
+        [[nodiscard]] std::size_t getVertex3Index() const noexcept {
+            return vertexIndex3;
+        }
+    };
+}
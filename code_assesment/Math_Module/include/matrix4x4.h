@@ -1,11 +1,13 @@
 #pragma once
 #include <cmath>
 #include "Vector3D.h"
+#include "vector4d.h"
 
 namespace Math {
     class Matrix4x4 {
     private:
-        float m[4][4];
+        // Rows are 16-byte aligned so each loads as one Vector4D
+        alignas(16) float m[4][4];
 
     public:
         // Initialize identity matrix
@@ -25,8 +27,24 @@ namespace Math {
             return m[row][col];
         }
 
+        [[nodiscard]] bool operator==(const Matrix4x4&) const noexcept = default;
+
         [[nodiscard]] Matrix4x4 operator*(const Matrix4x4& other) const noexcept {
             Matrix4x4 result;
+#ifdef MATH_SIMD_SSE2
+            // Each result row is a linear combination of the other matrix's rows
+            const __m128 row0 = _mm_load_ps(other.m[0]);
+            const __m128 row1 = _mm_load_ps(other.m[1]);
+            const __m128 row2 = _mm_load_ps(other.m[2]);
+            const __m128 row3 = _mm_load_ps(other.m[3]);
+            for (int i = 0; i < 4; i++) {
+                __m128 sum = _mm_mul_ps(_mm_set1_ps(m[i][0]), row0);
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][1]), row1));
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][2]), row2));
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(m[i][3]), row3));
+                _mm_store_ps(result.m[i], sum);
+            }
+#else
             for (int i = 0; i < 4; i++) {
                 for (int j = 0; j < 4; j++) {
                     float sum = 0.0f;
@@ -36,9 +54,36 @@ namespace Math {
                     result.m[i][j] = sum;
                 }
             }
+#endif
             return result;
         }
 
+        // Full homogeneous transform without the perspective divide
+        [[nodiscard]] Vector4D transform(const Vector4D& v) const noexcept {
+#ifdef MATH_SIMD_SSE2
+            __m128 p0 = _mm_mul_ps(_mm_load_ps(m[0]), v.load());
+            __m128 p1 = _mm_mul_ps(_mm_load_ps(m[1]), v.load());
+            __m128 p2 = _mm_mul_ps(_mm_load_ps(m[2]), v.load());
+            __m128 p3 = _mm_mul_ps(_mm_load_ps(m[3]), v.load());
+            _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+            return Vector4D::store(_mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3)));
+#else
+            return Vector4D(
+                m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3] * v.w,
+                m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3] * v.w,
+                m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z + m[2][3] * v.w,
+                m[3][0] * v.x + m[3][1] * v.y + m[3][2] * v.z + m[3][3] * v.w);
+#endif
+        }
+
+        [[nodiscard]] Vector4D getRow(int row) const noexcept {
+            return Vector4D(m[row][0], m[row][1], m[row][2], m[row][3]);
+        }
+
+        [[nodiscard]] Vector4D getColumn(int col) const noexcept {
+            return Vector4D(m[0][col], m[1][col], m[2][col], m[3][col]);
+        }
+
         [[nodiscard]] Vector3D transform(const Vector3D& v) const noexcept {
             const float x = m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z + m[0][3];
             const float y = m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z + m[1][3];
@@ -104,4 +149,32 @@ namespace Math {
             return result;
         }
     };
+
+    // Transforms many points by one matrix: columns are extracted once, then each point
+    // costs three broadcasts and a multiply-add chain. Results match Matrix4x4::transform(Vector3D).
+    class PointTransformer {
+    private:
+        Vector4D column0, column1, column2, column3;
+
+    public:
+        explicit PointTransformer(const Matrix4x4& matrix) noexcept
+            : column0(matrix.getColumn(0)), column1(matrix.getColumn(1)),
+              column2(matrix.getColumn(2)), column3(matrix.getColumn(3)) {
+        }
+
+        [[nodiscard]] Vector3D operator()(const Vector3D& v) const noexcept {
+#ifdef MATH_SIMD_SSE2
+            __m128 sum = _mm_mul_ps(_mm_set1_ps(v.x), column0.load());
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(v.y), column1.load()));
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(v.z), column2.load()));
+            const Vector4D r = Vector4D::store(_mm_add_ps(sum, column3.load()));
+#else
+            const Vector4D r = column0 * v.x + column1 * v.y + column2 * v.z + column3;
+#endif
+            if (std::abs(r.w) > 1e-6f) {
+                return Vector3D(r.x / r.w, r.y / r.w, r.z / r.w);
+            }
+            return r.xyz();
+        }
+    };
 }
\ No newline at end of file
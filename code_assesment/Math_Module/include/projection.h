@@ -1,6 +1,7 @@
 #pragma once
 #include "Vector3D.h"
 #include "Vector2D.h"
+#include "vector4d.h"
 
 namespace Math {
     // Orthographic projection
@@ -19,4 +20,13 @@ namespace Math {
         float scale = focalLength / (focalLength + v.z);
         return Vector2D(v.x * scale, v.y * scale);
     }
+
+    // Vector4D front ends (w is ignored)
+    [[nodiscard]] inline Vector2D orthographicProject(const Vector4D& v) noexcept {
+        return Vector2D(v.x, v.y);
+    }
+
+    [[nodiscard]] inline Vector2D perspectiveProject(const Vector4D& v, float focalLength = 1.0f) noexcept {
+        return perspectiveProject(v.xyz(), focalLength);
+    }
 }
\ No newline at end of file
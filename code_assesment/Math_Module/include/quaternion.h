@@ -0,0 +1,120 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include "Vector3D.h"
+#include "matrix4x4.h"
+
+namespace Math {
+    // Unit quaternion for accumulating rotations without Euler angles (no gimbal lock, no wrapping)
+    class Quaternion {
+    public:
+        float w, x, y, z;
+
+        constexpr Quaternion() noexcept : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
+        constexpr explicit Quaternion(float w, float x, float y, float z) noexcept : w(w), x(x), y(y), z(z) {}
+
+        // 'axis' must be unit length
+        [[nodiscard]] static Quaternion fromAxisAngle(const Vector3D& axis, float angle) noexcept {
+            const float s = std::sin(angle * 0.5f);
+            return Quaternion(std::cos(angle * 0.5f), axis.x * s, axis.y * s, axis.z * s);
+        }
+
+        // Rotation by 'other' followed by this one, matching Matrix4x4 composition order
+        [[nodiscard]] constexpr Quaternion operator*(const Quaternion& other) const noexcept {
+            return Quaternion(
+                w * other.w - x * other.x - y * other.y - z * other.z,
+                w * other.x + x * other.w + y * other.z - z * other.y,
+                w * other.y - x * other.z + y * other.w + z * other.x,
+                w * other.z + x * other.y - y * other.x + z * other.w);
+        }
+
+        [[nodiscard]] inline float length() const noexcept {
+            return std::sqrt(w * w + x * x + y * y + z * z);
+        }
+
+        // Repeated products drift off unit length; renormalizing keeps toMatrix a pure rotation
+        [[nodiscard]] inline Quaternion normalize() const noexcept {
+            const float len = length();
+            if (len > 0.0f) {
+                return Quaternion(w / len, x / len, y / len, z / len);
+            }
+            return Quaternion();
+        }
+
+        [[nodiscard]] constexpr Matrix4x4 toMatrix() const noexcept {
+            const float xx = x * x, yy = y * y, zz = z * z;
+            const float xy = x * y, xz = x * z, yz = y * z;
+            const float wx = w * x, wy = w * y, wz = w * z;
+
+            Matrix4x4 result;
+            result.set(0, 0, 1.0f - 2.0f * (yy + zz));
+            result.set(0, 1, 2.0f * (xy - wz));
+            result.set(0, 2, 2.0f * (xz + wy));
+            result.set(1, 0, 2.0f * (xy + wz));
+            result.set(1, 1, 1.0f - 2.0f * (xx + zz));
+            result.set(1, 2, 2.0f * (yz - wx));
+            result.set(2, 0, 2.0f * (xz - wy));
+            result.set(2, 1, 2.0f * (yz + wx));
+            result.set(2, 2, 1.0f - 2.0f * (xx + yy));
+            return result;
+        }
+    };
+
+    // Trackball-style orientation driven by mouse deltas. Each drag step rotates about the view-space
+    // axis perpendicular to the drag (horizontal about Y, vertical about X), so the object always turns
+    // the way the mouse moves regardless of its current orientation. A drag costs one sin/cos pair and
+    // a quaternion product; the matrix is only rebuilt when read after a change.
+    class ArcballController {
+    private:
+        Quaternion orientation;
+        float radiansPerPixel;
+        uint64_t revision = 0;
+        mutable bool matrixDirty = false;
+        mutable Matrix4x4 cachedMatrix;
+
+    public:
+        explicit ArcballController(float radiansPerPixel = 0.005f) noexcept
+            : radiansPerPixel(radiansPerPixel) {
+        }
+
+        void drag(int deltaX, int deltaY) noexcept {
+            const float dx = static_cast<float>(deltaX);
+            const float dy = static_cast<float>(deltaY);
+            const float pixels = std::sqrt(dx * dx + dy * dy);
+            if (pixels == 0.0f) return;
+
+            // Pre-multiplying applies the step in view space, after the accumulated orientation
+            const Vector3D axis(dy / pixels, dx / pixels, 0.0f);
+            orientation = (Quaternion::fromAxisAngle(axis, pixels * radiansPerPixel) * orientation).normalize();
+            matrixDirty = true;
+            ++revision;
+        }
+
+        void setOrientation(const Quaternion& q) noexcept {
+            orientation = q.normalize();
+            matrixDirty = true;
+            ++revision;
+        }
+
+        void reset() noexcept {
+            setOrientation(Quaternion());
+        }
+
+        [[nodiscard]] const Quaternion& getOrientation() const noexcept {
+            return orientation;
+        }
+
+        // Bumped by every change; lets callers rebuild dependent state once per frame rather than per event
+        [[nodiscard]] uint64_t getRevision() const noexcept {
+            return revision;
+        }
+
+        [[nodiscard]] const Matrix4x4& getMatrix() const noexcept {
+            if (matrixDirty) {
+                cachedMatrix = orientation.toMatrix();
+                matrixDirty = false;
+            }
+            return cachedMatrix;
+        }
+    };
+}
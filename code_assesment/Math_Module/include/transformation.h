@@ -84,6 +84,12 @@ namespace Math {
             matrixDirty = true;
         }
 
+        // Precomputed transform, e.g. an orientation kept outside the pipeline
+        void addMatrix(const Matrix4x4& matrix) noexcept {
+            operations.emplace_back(matrix);
+            matrixDirty = true;
+        }
+
         // Lazy evaluation - only compute when needed
         [[nodiscard]] const Matrix4x4& getTransformMatrix() const noexcept {
             if (matrixDirty) {
@@ -0,0 +1,142 @@
+#pragma once
+#include <cmath>
+#include "Vector3D.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MATH_SIMD_SSE2 1
+#endif
+
+namespace Math {
+    // 16-byte aligned 4-lane vector that maps directly onto one SIMD register.
+    // dot3/cross/length/normalize treat w as padding and leave it untouched where noted.
+    class alignas(16) Vector4D {
+    public:
+        float x, y, z, w;
+
+        constexpr Vector4D() noexcept : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+        constexpr explicit Vector4D(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+        constexpr explicit Vector4D(const Vector3D& v, float w = 0.0f) noexcept : x(v.x), y(v.y), z(v.z), w(w) {}
+
+        [[nodiscard]] constexpr Vector3D xyz() const noexcept {
+            return Vector3D(x, y, z);
+        }
+
+#ifdef MATH_SIMD_SSE2
+        [[nodiscard]] inline __m128 load() const noexcept {
+            return _mm_load_ps(&x);
+        }
+
+        [[nodiscard]] static inline Vector4D store(__m128 v) noexcept {
+            Vector4D result;
+            _mm_store_ps(&result.x, v);
+            return result;
+        }
+
+        [[nodiscard]] static inline float horizontalSum(__m128 v) noexcept {
+            __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(v, shuffled);
+            shuffled = _mm_movehl_ps(shuffled, sums);
+            sums = _mm_add_ss(sums, shuffled);
+            return _mm_cvtss_f32(sums);
+        }
+
+        [[nodiscard]] static inline __m128 xyzMask() noexcept {
+            return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        }
+
+        [[nodiscard]] inline Vector4D operator+(const Vector4D& v) const noexcept {
+            return store(_mm_add_ps(load(), v.load()));
+        }
+
+        [[nodiscard]] inline Vector4D operator-(const Vector4D& v) const noexcept {
+            return store(_mm_sub_ps(load(), v.load()));
+        }
+
+        [[nodiscard]] inline Vector4D operator*(float scalar) const noexcept {
+            return store(_mm_mul_ps(load(), _mm_set1_ps(scalar)));
+        }
+
+        // Component-wise product
+        [[nodiscard]] inline Vector4D operator*(const Vector4D& v) const noexcept {
+            return store(_mm_mul_ps(load(), v.load()));
+        }
+
+        [[nodiscard]] inline float dot(const Vector4D& v) const noexcept {
+            return horizontalSum(_mm_mul_ps(load(), v.load()));
+        }
+
+        [[nodiscard]] inline float dot3(const Vector4D& v) const noexcept {
+            return horizontalSum(_mm_and_ps(_mm_mul_ps(load(), v.load()), xyzMask()));
+        }
+
+        // 3D cross product; w of the result is 0
+        [[nodiscard]] inline Vector4D cross(const Vector4D& v) const noexcept {
+            const __m128 a = load();
+            const __m128 b = v.load();
+            const __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+            return store(_mm_and_ps(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)), xyzMask()));
+        }
+
+        [[nodiscard]] inline float length() const noexcept {
+            return std::sqrt(dot3(*this));
+        }
+
+        // Normalizes xyz; w is preserved
+        [[nodiscard]] inline Vector4D normalize() const noexcept {
+            const float len = length();
+            if (len > 0.0f) {
+                const __m128 v = load();
+                const __m128 scaled = _mm_div_ps(v, _mm_set1_ps(len));
+                const __m128 mask = xyzMask();
+                return store(_mm_or_ps(_mm_and_ps(mask, scaled), _mm_andnot_ps(mask, v)));
+            }
+            return *this;
+        }
+#else
+        [[nodiscard]] constexpr Vector4D operator+(const Vector4D& v) const noexcept {
+            return Vector4D(x + v.x, y + v.y, z + v.z, w + v.w);
+        }
+
+        [[nodiscard]] constexpr Vector4D operator-(const Vector4D& v) const noexcept {
+            return Vector4D(x - v.x, y - v.y, z - v.z, w - v.w);
+        }
+
+        [[nodiscard]] constexpr Vector4D operator*(float scalar) const noexcept {
+            return Vector4D(x * scalar, y * scalar, z * scalar, w * scalar);
+        }
+
+        // Component-wise product
+        [[nodiscard]] constexpr Vector4D operator*(const Vector4D& v) const noexcept {
+            return Vector4D(x * v.x, y * v.y, z * v.z, w * v.w);
+        }
+
+        [[nodiscard]] constexpr float dot(const Vector4D& v) const noexcept {
+            return x * v.x + y * v.y + z * v.z + w * v.w;
+        }
+
+        [[nodiscard]] constexpr float dot3(const Vector4D& v) const noexcept {
+            return x * v.x + y * v.y + z * v.z;
+        }
+
+        // 3D cross product; w of the result is 0
+        [[nodiscard]] constexpr Vector4D cross(const Vector4D& v) const noexcept {
+            return Vector4D(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x, 0.0f);
+        }
+
+        [[nodiscard]] inline float length() const noexcept {
+            return std::sqrt(dot3(*this));
+        }
+
+        // Normalizes xyz; w is preserved
+        [[nodiscard]] inline Vector4D normalize() const noexcept {
+            const float len = length();
+            return (len > 0.0f) ? Vector4D(x / len, y / len, z / len, w) : *this;
+        }
+#endif
+    };
+
+    static_assert(sizeof(Vector4D) == 16 && alignof(Vector4D) == 16, "Vector4D must fill exactly one SIMD register");
+}
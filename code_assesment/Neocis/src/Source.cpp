@@ -5,13 +5,19 @@
 
 // Application entry point
 int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow) {
-    try {        
+    try {
         // Create window renderer with 800x600 resolution
         Render::WindowRenderer renderer(800, 600, L"3D Wireframe Viewer");
 
         // Load the default tetrahedron
         renderer.LoadTetrahedron();
 
+        // A mesh passed on the command line (e.g. dropped onto the exe) replaces it once loaded;
+        // headless batch rendering lives in Render_Batch
+        if (__argc > 1) {
+            renderer.LoadFile(__argv[1]);
+        }
+
         // Run the main message loop
         return renderer.Run();
     }
@@ -19,4 +25,4 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLi
         MessageBoxA(NULL, e.what(), "Error", MB_ICONERROR);
         return 1;
     }
-}
\ No newline at end of file
+}
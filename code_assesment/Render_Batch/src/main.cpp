@@ -0,0 +1,104 @@
+// Headless batch renderer: renders every job in a spec file (see Render::BatchSpec).
+//   Render_Batch --batch <jobs.txt> [--threads <n>] [--report <file>] [--stats]
+// The per-job throughput report goes to stdout and, with --report, to a file as well. --stats adds
+// per-stage frame time percentiles over all workers (Render::RenderStats) to stdout. Errors go to
+// stderr. Exit code 0 when every frame rendered, 1 when a job failed, 2 on bad arguments or an
+// unexpected error.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "batch_render.h"
+
+namespace {
+    struct BatchOptions {
+        std::string specFile;
+        std::string reportFile;
+        unsigned threads = 0;       // 0 = one worker per hardware thread
+        bool stats = false;
+    };
+
+    [[nodiscard]] BatchOptions parseArguments(int argc, char** argv) {
+        BatchOptions options;
+        for (int i = 1; i < argc; ++i) {
+            const std::string option = argv[i];
+            if (option == "--stats") {
+                options.stats = true;
+                continue;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + option);
+            const std::string value = argv[++i];
+            if (option == "--batch") options.specFile = value;
+            else if (option == "--threads") {
+                char* end = nullptr;
+                const unsigned long threads = std::strtoul(value.c_str(), &end, 10);
+                if (value.empty() || *end != '\0') throw std::invalid_argument("Invalid value for --threads: " + value);
+                options.threads = static_cast<unsigned>(threads);
+            }
+            else if (option == "--report") options.reportFile = value;
+            else throw std::invalid_argument("Unknown option: " + option);
+        }
+        if (options.specFile.empty()) {
+            throw std::invalid_argument("Usage: Render_Batch --batch <jobs.txt> [--threads <n>] [--report <file>] [--stats]");
+        }
+        return options;
+    }
+
+    // Number of jobs with an error or failed frames
+    int runBatch(const BatchOptions& options) {
+        const auto jobs = Render::BatchSpec::loadFile(options.specFile);
+        const Render::BatchRenderer batch(options.threads);
+
+        // With --stats the window keeps every frame of a typical batch in the percentiles
+        Render::RenderStats stats(options.stats ? 16384 : 1);
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = batch.run(jobs, options.stats ? &stats : nullptr);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        Render::BatchRenderer::writeReport(std::cout, results, seconds);
+        if (options.stats) {
+            std::cout << "# render stats over " << stats.getFramesRecorded() << " frames\n" << stats.formatReport();
+        }
+        std::cout.flush();
+        if (!options.reportFile.empty()) {
+            std::ofstream report(options.reportFile);
+            if (!report.is_open()) {
+                throw std::runtime_error("Failed to open report: " + options.reportFile);
+            }
+            Render::BatchRenderer::writeReport(report, results, seconds);
+        }
+
+        int failed = 0;
+        for (const auto& result : results) {
+            if (result.framesFailed > 0 || !result.error.empty()) {
+                std::fprintf(stderr, "%s: %s\n", result.meshPath.c_str(),
+                    result.error.empty() ? "frames failed" : result.error.c_str());
+                ++failed;
+            }
+        }
+        return failed;
+    }
+}
+
+int main(int argc, char** argv) {
+    BatchOptions options;
+    try {
+        options = parseArguments(argc, argv);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    try {
+        return runBatch(options) == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 2;
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+// Global heap allocation counting. The counting operator new/delete replacements are only
+// compiled in when RENDER_COUNT_ALLOCATIONS is defined; otherwise every count reads zero.
+#include <cstdint>
+
+namespace Render {
+    namespace AllocationCounter {
+        [[nodiscard]] bool isEnabled() noexcept;
+
+        // Allocations made by the calling thread since it started
+        [[nodiscard]] uint64_t threadCount() noexcept;
+
+        // Allocations made by all threads
+        [[nodiscard]] uint64_t globalCount() noexcept;
+    }
+
+    // Counts allocations on the current thread over a scope
+    class ScopedAllocationCount {
+    private:
+        uint64_t start;
+
+    public:
+        ScopedAllocationCount() noexcept : start(AllocationCounter::threadCount()) {}
+
+        [[nodiscard]] uint64_t delta() const noexcept {
+            return AllocationCounter::threadCount() - start;
+        }
+    };
+}
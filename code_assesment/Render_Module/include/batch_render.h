@@ -0,0 +1,105 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+#include "renderer.h"
+#include "matrix4x4.h"
+#include "color.h"
+
+namespace Render {
+    enum class BatchOutputFormat {
+        PPM, // One file per frame: <prefix>_<frame>.ppm
+        QOI, // One file per frame: <prefix>_<frame>.qoi
+        Y4M  // All frames in <prefix>.y4m, in frame order
+    };
+
+    // Orbit around the object, interpolated linearly over the job's frames. Angles are radians and
+    // composed as pitch about X, then yaw about Y, then pull back along -Z.
+    struct CameraPath {
+        static constexpr float DegreesToRadians = 3.14159265358979f / 180.0f;
+
+        float startYaw = 0.0f;
+        float endYaw = 6.28318530718f;
+        float startPitch = 0.0f;
+        float endPitch = 0.0f;
+        float distance = 0.0f; // 0 = fit the object like the viewer does
+        bool loop = true;      // The end pose equals the start pose, so the last frame stops one step short
+
+        [[nodiscard]] Math::Matrix4x4 matrixAt(int frame, int frameCount, float fitDistance) const;
+
+        // A single pose, angles in degrees as in job specs
+        [[nodiscard]] static CameraPath fixed(float yawDegrees, float pitchDegrees, float distance = 0.0f) noexcept;
+    };
+
+    struct BatchJob {
+        std::string meshPath;
+        std::string outputPrefix;
+        int width = 800;
+        int height = 600;
+        int frameCount = 36;
+        CameraPath camera;
+        BatchOutputFormat format = BatchOutputFormat::QOI;
+        LineMode lineMode = LineMode::Aliased;
+        bool hiddenLines = false;
+        int vertexRadius = 3;
+        Color background = Color::Black();
+        Color color = Color::Blue();
+        int bandHeight = 0; // > 0: render each frame out of core in bands of this many rows (see PosterRenderer) on the batch worker alone
+    };
+
+    struct BatchJobResult {
+        std::string meshPath;
+        int framesRendered = 0;
+        int framesFailed = 0;
+        size_t vertexCount = 0;
+        size_t edgeCount = 0;
+        double loadSeconds = 0.0;
+        double renderSeconds = 0.0; // Summed over workers, including output
+        double wallSeconds = 0.0;   // First frame claimed to last frame finished
+        std::string error;          // Empty on success
+
+        [[nodiscard]] double framesPerSecond() const noexcept {
+            return wallSeconds > 0.0 ? framesRendered / wallSeconds : 0.0;
+        }
+    };
+
+    namespace BatchSpec {
+        // One job per line as whitespace-separated key=value pairs; '#' starts a comment.
+        //   mesh=<path>          required
+        //   out=<prefix>         output path prefix (default: mesh path without extension)
+        //   size=<w>x<h>         frames=<n>          format=ppm|qoi|y4m
+        //   yaw=<deg>[:<deg>]    pitch=<deg>[:<deg>] distance=<units>    loop=0|1
+        //   lines=aliased|aa|subpixel               hidden=0|1          radius=<px>
+        //   band=<rows>          out-of-core rendering for huge frames; needs format=ppm, lines=aliased, hidden=0
+        // Throws std::runtime_error naming the line on malformed input.
+        [[nodiscard]] std::vector<BatchJob> parse(std::istream& in);
+        [[nodiscard]] std::vector<BatchJob> loadFile(const std::string& filename);
+    }
+
+    // Renders many jobs at once. Frames, not jobs, are the unit of work: workers claim frames in job
+    // order from a shared counter, so a batch of small assets and a single long turntable both keep
+    // every core busy. Each mesh is loaded once by the first worker to reach it, shared read-only
+    // between workers and released when its last frame is done, so only the jobs in flight are resident.
+    class BatchRenderer {
+    private:
+        unsigned workerCount;
+
+    public:
+        // 0 workers = one per hardware thread
+        explicit BatchRenderer(unsigned workers = 0) noexcept;
+
+        // Blocks until every job has finished; one result per job, in job order. A job that fails to
+        // load or write reports it in its result and does not affect the others. With 'stats', each
+        // worker records its frames (banded frames excepted) and they are merged into it at the end.
+        [[nodiscard]] std::vector<BatchJobResult> run(const std::vector<BatchJob>& jobs, RenderStats* stats = nullptr) const;
+
+        [[nodiscard]] unsigned getWorkerCount() const noexcept {
+            return workerCount;
+        }
+
+        // Tab-separated per-job table followed by a totals line
+        static void writeReport(std::ostream& out, const std::vector<BatchJobResult>& results, double wallSeconds);
+    };
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "framebuffer.h"
+
+namespace Render {
+    // Bit-packed target for wireframes: each pixel is a 1, 2 or 4-bit index into a small palette
+    // instead of 3 bytes of colour, so an 8k x 8k mask frame is 8 MB rather than 192 MB and primitives
+    // write a fraction of the memory traffic. Index 0 is the background; clear() sets its colour.
+    // Only the background colour itself maps to index 0: any other colour written with setPixel sets
+    // coverage and maps to the nearest of the remaining entries (exact matches are the fast path), so a
+    // 1-bit mask records every line whatever its colour and anti-aliased blends count as covered.
+    // Pixels are expanded to full colour only on output.
+    class CoverageMaskTarget final : public LinearConvertibleTarget {
+    public:
+        static constexpr int MaxPaletteSize = 16;
+
+    private:
+        int width, height;
+        int bitsPerPixel;
+        int pixelsPerWordShift; // log2(64 / bitsPerPixel)
+        size_t wordsPerRow;
+        std::vector<uint64_t> words; // Rows start on a word boundary
+        std::array<Color, MaxPaletteSize> palette;
+        Color lastColor;     // Most recent setPixel colour and its index
+        uint8_t lastIndex = 0;
+
+        [[nodiscard]] uint8_t paletteIndexOf(const Color& color) noexcept;
+
+    public:
+        // 'bitsPerPixel' is 1 (mask: background + one colour), 2 or 4; throws std::invalid_argument otherwise.
+        // The default palette is black, blue, white, red, green, then black.
+        explicit CoverageMaskTarget(int width, int height, int bitsPerPixel = 1);
+
+        void setPixel(int x, int y, const Color& color) noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                const uint64_t index = paletteIndexOf(color);
+                const size_t bit = static_cast<size_t>(x) * bitsPerPixel;
+                uint64_t& word = words[static_cast<size_t>(y) * wordsPerRow + (bit >> 6)];
+                const unsigned shift = static_cast<unsigned>(bit & 63);
+                const uint64_t mask = ((uint64_t{ 1 } << bitsPerPixel) - 1) << shift;
+                word = (word & ~mask) | (index << shift);
+            }
+        }
+
+        [[nodiscard]] Color getPixel(int x, int y) const noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                return palette[getIndex(x, y)];
+            }
+            return Color::Black();
+        }
+
+        [[nodiscard]] int getWidth() const noexcept override { return width; }
+        [[nodiscard]] int getHeight() const noexcept override { return height; }
+
+        // Sets palette entry 0 to 'color' and every pixel to it
+        void clear(const Color& color = Color::Black()) noexcept override;
+
+        // Palette index at an in-bounds pixel
+        [[nodiscard]] uint8_t getIndex(int x, int y) const noexcept {
+            const size_t bit = static_cast<size_t>(x) * bitsPerPixel;
+            const uint64_t word = words[static_cast<size_t>(y) * wordsPerRow + (bit >> 6)];
+            return static_cast<uint8_t>((word >> (bit & 63)) & ((uint64_t{ 1 } << bitsPerPixel) - 1));
+        }
+
+        [[nodiscard]] int getBitsPerPixel() const noexcept { return bitsPerPixel; }
+        [[nodiscard]] int getPaletteSize() const noexcept { return 1 << bitsPerPixel; }
+
+        // Recolours every pixel with that index; out-of-range indices are ignored
+        void setPaletteColor(int index, const Color& color) noexcept;
+
+        [[nodiscard]] Color getPaletteColor(int index) const noexcept {
+            return (index >= 0 && index < getPaletteSize()) ? palette[index] : Color::Black();
+        }
+
+        // Packed storage: row y starts at word y * getWordsPerRow(), pixel x at bit x * bitsPerPixel
+        [[nodiscard]] const uint64_t* getWords() const noexcept { return words.data(); }
+        [[nodiscard]] size_t getWordsPerRow() const noexcept { return wordsPerRow; }
+
+        // Runs of background words expand as a fill
+        void copyToLinear(Color* out) const noexcept override;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "render_target_interface.h"
+#include "view_transform.h"
+#include "vertex.h"
+#include "color.h"
+
+namespace Render {
+    enum class DensityToneMap {
+        Linear,     // count / saturation
+        Logarithmic // log(1 + count) / log(1 + saturation); keeps sparse regions visible
+    };
+
+    struct DensitySplatOptions {
+        DensityToneMap toneMap = DensityToneMap::Logarithmic;
+        Color background = Color::Black();
+        Color low = Color(20, 40, 160);  // One point
+        Color high = Color::White();     // 'saturation' points or more
+        uint32_t saturation = 0;         // 0 = the densest pixel of the frame
+    };
+
+    // Point-cloud rendering as a density image: every point adds one to the count of the pixel it
+    // projects to (same mapping as the renderer's vertices), and counts are tone-mapped to colours.
+    // Large clouds are split across threads, each counting into its own buffer; the buffers are
+    // summed at the end, so no atomics are needed. Buffers are kept between frames.
+    class DensitySplatter {
+    private:
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> counts;
+        std::vector<std::vector<uint32_t>> workerCounts; // Chunks after the first
+        uint32_t maxCount = 0;
+        std::vector<Color> toneTable; // Colours for small counts, rebuilt by resolve()
+
+    public:
+        // Points per thread below which accumulation stays on the calling thread
+        static constexpr size_t ChunkPoints = size_t{ 1 } << 18;
+
+        // Replaces the counts with the projection of 'points' onto a width x height image
+        void accumulate(std::span<const Vertex> points, int width, int height, const ViewTransform* view = nullptr);
+
+        // Tone-maps the counts into 'target' (which should match the accumulated size)
+        void resolve(IRenderTarget& target, const DensitySplatOptions& options = {});
+
+        [[nodiscard]] std::span<const uint32_t> getCounts() const noexcept {
+            return counts;
+        }
+
+        [[nodiscard]] uint32_t getMaxCount() const noexcept {
+            return maxCount;
+        }
+
+        [[nodiscard]] int getWidth() const noexcept { return width; }
+        [[nodiscard]] int getHeight() const noexcept { return height; }
+    };
+}
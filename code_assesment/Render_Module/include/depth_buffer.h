@@ -0,0 +1,163 @@
+#pragma once
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#undef max
+#undef min
+
+namespace Render {
+    // Per-pixel depth plus a max-depth pyramid (hierarchical Z) for early rejection.
+    // Depth grows away from the viewer; cleared pixels are at +infinity.
+    class DepthBuffer {
+    private:
+        struct Level {
+            int width, height;
+            std::vector<float> depth;
+        };
+
+        int width, height;
+        std::vector<float> depth;
+        std::vector<Level> pyramid; // pyramid[k] cell covers 2^(k+1) x 2^(k+1) pixels
+
+        static float edgeFunction(float ax, float ay, float bx, float by, float px, float py) noexcept {
+            return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        }
+
+    public:
+        explicit DepthBuffer(int width, int height) : width(width), height(height) {
+            depth.resize(static_cast<size_t>(width) * static_cast<size_t>(height), std::numeric_limits<float>::infinity());
+
+            int w = width, h = height;
+            while (w > 1 || h > 1) {
+                w = (w + 1) / 2;
+                h = (h + 1) / 2;
+                pyramid.push_back(Level{ w, h, std::vector<float>(static_cast<size_t>(w) * h, std::numeric_limits<float>::infinity()) });
+            }
+        }
+
+        [[nodiscard]] int getWidth() const noexcept { return width; }
+        [[nodiscard]] int getHeight() const noexcept { return height; }
+
+        void clear() noexcept {
+            std::fill(depth.begin(), depth.end(), std::numeric_limits<float>::infinity());
+            for (auto& level : pyramid) {
+                std::fill(level.depth.begin(), level.depth.end(), std::numeric_limits<float>::infinity());
+            }
+        }
+
+        [[nodiscard]] float getDepth(int x, int y) const noexcept {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                return depth[static_cast<size_t>(y) * width + x];
+            }
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // Screen-space triangle, sampled at pixel centres; depth is interpolated linearly
+        void rasterizeTriangle(float x0, float y0, float z0, float x1, float y1, float z1,
+            float x2, float y2, float z2) noexcept {
+            float area = edgeFunction(x0, y0, x1, y1, x2, y2);
+            if (std::abs(area) < 1e-12f) return;
+
+            // Accept either winding; faces are used as occluders, not culled
+            if (area < 0.0f) {
+                std::swap(x1, x2);
+                std::swap(y1, y2);
+                std::swap(z1, z2);
+                area = -area;
+            }
+
+            const int minX = std::max(0, static_cast<int>(std::floor(std::min({ x0, x1, x2 }))));
+            const int maxX = std::min(width - 1, static_cast<int>(std::ceil(std::max({ x0, x1, x2 }))));
+            const int minY = std::max(0, static_cast<int>(std::floor(std::min({ y0, y1, y2 }))));
+            const int maxY = std::min(height - 1, static_cast<int>(std::ceil(std::max({ y0, y1, y2 }))));
+            if (minX > maxX || minY > maxY) return;
+
+            const float invArea = 1.0f / area;
+
+            for (int y = minY; y <= maxY; ++y) {
+                const float py = static_cast<float>(y) + 0.5f;
+                float* row = depth.data() + static_cast<size_t>(y) * width;
+
+                for (int x = minX; x <= maxX; ++x) {
+                    const float px = static_cast<float>(x) + 0.5f;
+                    const float w0 = edgeFunction(x1, y1, x2, y2, px, py);
+                    const float w1 = edgeFunction(x2, y2, x0, y0, px, py);
+                    const float w2 = edgeFunction(x0, y0, x1, y1, px, py);
+
+                    if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+                        const float z = (w0 * z0 + w1 * z1 + w2 * z2) * invArea;
+                        if (z < row[x]) {
+                            row[x] = z;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Rebuild the max-depth pyramid after all occluders are rasterized
+        void buildPyramid() noexcept {
+            const float* src = depth.data();
+            int srcW = width, srcH = height;
+
+            for (auto& level : pyramid) {
+                for (int y = 0; y < level.height; ++y) {
+                    const int sy0 = 2 * y;
+                    const int sy1 = std::min(sy0 + 1, srcH - 1);
+                    for (int x = 0; x < level.width; ++x) {
+                        const int sx0 = 2 * x;
+                        const int sx1 = std::min(sx0 + 1, srcW - 1);
+                        level.depth[static_cast<size_t>(y) * level.width + x] = std::max(
+                            std::max(src[static_cast<size_t>(sy0) * srcW + sx0], src[static_cast<size_t>(sy0) * srcW + sx1]),
+                            std::max(src[static_cast<size_t>(sy1) * srcW + sx0], src[static_cast<size_t>(sy1) * srcW + sx1]));
+                    }
+                }
+                src = level.depth.data();
+                srcW = level.width;
+                srcH = level.height;
+            }
+        }
+
+        // True when everything inside the pixel rect is nearer than 'nearestDepth'.
+        // Uses the coarsest pyramid level where the rect touches at most 2x2 cells.
+        [[nodiscard]] bool isRectOccluded(int x0, int y0, int x1, int y1, float nearestDepth) const noexcept {
+            x0 = std::max(x0, 0);
+            y0 = std::max(y0, 0);
+            x1 = std::min(x1, width - 1);
+            y1 = std::min(y1, height - 1);
+            if (x0 > x1 || y0 > y1) return false; // Off screen: nothing to reject
+
+            const int extent = std::max(x1 - x0, y1 - y0) + 1;
+            int levelIndex = -1;
+            int cellSize = 1;
+            while (cellSize < extent && levelIndex + 1 < static_cast<int>(pyramid.size())) {
+                ++levelIndex;
+                cellSize <<= 1;
+            }
+
+            if (levelIndex < 0) {
+                for (int y = y0; y <= y1; ++y) {
+                    for (int x = x0; x <= x1; ++x) {
+                        if (!(nearestDepth > depth[static_cast<size_t>(y) * width + x])) return false;
+                    }
+                }
+                return true;
+            }
+
+            const Level& level = pyramid[levelIndex];
+            const int shift = levelIndex + 1;
+            for (int y = y0 >> shift; y <= (y1 >> shift); ++y) {
+                for (int x = x0 >> shift; x <= (x1 >> shift); ++x) {
+                    if (!(nearestDepth > level.depth[static_cast<size_t>(y) * level.width + x])) return false;
+                }
+            }
+            return true;
+        }
+
+        // Per-pixel visibility with a bias so edges lying on a face pass
+        [[nodiscard]] bool isVisible(int x, int y, float z, float bias) const noexcept {
+            return z <= getDepth(x, y) + bias;
+        }
+    };
+}
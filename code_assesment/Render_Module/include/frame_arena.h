@@ -0,0 +1,111 @@
+#pragma once
+#include <memory_resource>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#undef max
+#undef min
+
+namespace Render {
+    // Monotonic bump allocator for data that lives for one frame.
+    // reset() rewinds without freeing, and coalesces overflow blocks into one,
+    // so once the arena has seen the largest frame it never touches the heap again.
+    class FrameArena final : public std::pmr::memory_resource {
+    private:
+        struct Block {
+            std::unique_ptr<std::byte[]> data;
+            size_t size;
+        };
+
+        std::vector<Block> blocks;
+        size_t blockIndex = 0;
+        size_t offset = 0;
+        size_t bytesUsed = 0;
+        size_t highWater = 0;
+
+        void addBlock(size_t minimumSize) {
+            const size_t lastSize = blocks.empty() ? 0 : blocks.back().size;
+            const size_t size = std::max({ minimumSize, lastSize * 2, static_cast<size_t>(4096) });
+            blocks.push_back(Block{ std::make_unique<std::byte[]>(size), size });
+        }
+
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            for (;;) {
+                if (blockIndex < blocks.size()) {
+                    Block& block = blocks[blockIndex];
+                    const auto base = reinterpret_cast<uintptr_t>(block.data.get());
+                    const uintptr_t aligned = (base + offset + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+                    const size_t end = static_cast<size_t>(aligned - base) + bytes;
+
+                    if (end <= block.size) {
+                        bytesUsed += end - offset;
+                        highWater = std::max(highWater, bytesUsed);
+                        offset = end;
+                        return reinterpret_cast<void*>(aligned);
+                    }
+
+                    // Try the next retained block before growing
+                    if (blockIndex + 1 < blocks.size()) {
+                        ++blockIndex;
+                        offset = 0;
+                        continue;
+                    }
+                }
+
+                addBlock(bytes + alignment);
+                blockIndex = blocks.size() - 1;
+                offset = 0;
+            }
+        }
+
+        void do_deallocate(void*, size_t, size_t) noexcept override {
+            // Memory is reclaimed all at once by reset()
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+
+    public:
+        explicit FrameArena(size_t initialSize = 64 * 1024) {
+            if (initialSize > 0) {
+                addBlock(initialSize);
+            }
+        }
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // Invalidate everything allocated since the last reset
+        void reset() {
+            blockIndex = 0;
+            offset = 0;
+            bytesUsed = 0;
+            if (blocks.size() > 1) {
+                size_t total = 0;
+                for (const auto& block : blocks) {
+                    total += block.size;
+                }
+                // Allocated before the old blocks are released, so a failure leaves them all in place
+                Block merged{ std::make_unique<std::byte[]>(total), total };
+                blocks.clear();
+                blocks.push_back(std::move(merged)); // Capacity is already > 1; cannot throw
+            }
+        }
+
+        [[nodiscard]] size_t getBytesUsed() const noexcept { return bytesUsed; }
+        [[nodiscard]] size_t getHighWater() const noexcept { return highWater; }
+        [[nodiscard]] size_t getBlockCount() const noexcept { return blocks.size(); }
+
+        [[nodiscard]] size_t getCapacity() const noexcept {
+            size_t total = 0;
+            for (const auto& block : blocks) {
+                total += block.size;
+            }
+            return total;
+        }
+    };
+}
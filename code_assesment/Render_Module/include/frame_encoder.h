@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include "color.h"
+
+namespace Render {
+    static_assert(sizeof(Color) == 3, "Color must be tightly packed RGB for bulk encoding");
+
+    // Strategy interface for turning a linear RGB frame into file bytes
+    class IFrameEncoder {
+    public:
+        // Appends the encoded image to 'out'
+        virtual void encode(const Color* pixels, int width, int height, std::vector<uint8_t>& out) const = 0;
+        [[nodiscard]] virtual const char* extension() const noexcept = 0;
+        virtual ~IFrameEncoder() = default;
+    };
+
+    // Binary PPM (P6): header followed by the raw pixel block
+    class PPMEncoder final : public IFrameEncoder {
+    public:
+        void encode(const Color* pixels, int width, int height, std::vector<uint8_t>& out) const override {
+            const std::string header = "P6\n" + std::to_string(width) + " " + std::to_string(height) + "\n255\n";
+            const size_t pixelBytes = static_cast<size_t>(width) * static_cast<size_t>(height) * sizeof(Color);
+            const size_t start = out.size();
+
+            out.resize(start + header.size() + pixelBytes);
+            std::memcpy(out.data() + start, header.data(), header.size());
+            std::memcpy(out.data() + start + header.size(), pixels, pixelBytes);
+        }
+
+        [[nodiscard]] const char* extension() const noexcept override { return "ppm"; }
+    };
+
+    // "Quite OK Image" format: lossless, single pass, much smaller than PPM for wireframes
+    class QOIEncoder final : public IFrameEncoder {
+    private:
+        static constexpr uint8_t OP_INDEX = 0x00;
+        static constexpr uint8_t OP_DIFF = 0x40;
+        static constexpr uint8_t OP_LUMA = 0x80;
+        static constexpr uint8_t OP_RUN = 0xc0;
+        static constexpr uint8_t OP_RGB = 0xfe;
+
+        static void put32(std::vector<uint8_t>& out, uint32_t v) {
+            out.push_back(static_cast<uint8_t>(v >> 24));
+            out.push_back(static_cast<uint8_t>(v >> 16));
+            out.push_back(static_cast<uint8_t>(v >> 8));
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        [[nodiscard]] static int hash(const Color& c) noexcept {
+            // Alpha is always 255
+            return (c.r * 3 + c.g * 5 + c.b * 7 + 255 * 11) % 64;
+        }
+
+    public:
+        void encode(const Color* pixels, int width, int height, std::vector<uint8_t>& out) const override {
+            const size_t count = static_cast<size_t>(width) * static_cast<size_t>(height);
+
+            // Worst case is 4 bytes per pixel plus header and end marker
+            out.reserve(out.size() + 14 + count * 4 + 8);
+
+            out.insert(out.end(), { 'q', 'o', 'i', 'f' });
+            put32(out, static_cast<uint32_t>(width));
+            put32(out, static_cast<uint32_t>(height));
+            out.push_back(3); // RGB
+            out.push_back(0); // sRGB
+
+            // Decoder's index starts as transparent black, which never equals an opaque pixel
+            Color index[64] = {};
+            bool indexValid[64] = {};
+            Color prev = Color::Black();
+            int run = 0;
+
+            for (size_t i = 0; i < count; ++i) {
+                const Color px = pixels[i];
+
+                if (px.r == prev.r && px.g == prev.g && px.b == prev.b) {
+                    ++run;
+                    if (run == 62 || i + 1 == count) {
+                        out.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0) {
+                    out.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+                    run = 0;
+                }
+
+                const int slot = hash(px);
+                const Color& cached = index[slot];
+                if (indexValid[slot] && cached.r == px.r && cached.g == px.g && cached.b == px.b) {
+                    out.push_back(static_cast<uint8_t>(OP_INDEX | slot));
+                }
+                else {
+                    index[slot] = px;
+                    indexValid[slot] = true;
+
+                    const int8_t vr = static_cast<int8_t>(px.r - prev.r);
+                    const int8_t vg = static_cast<int8_t>(px.g - prev.g);
+                    const int8_t vb = static_cast<int8_t>(px.b - prev.b);
+                    const int8_t vgr = static_cast<int8_t>(vr - vg);
+                    const int8_t vgb = static_cast<int8_t>(vb - vg);
+
+                    if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                        out.push_back(static_cast<uint8_t>(OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+                    }
+                    else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8) {
+                        out.push_back(static_cast<uint8_t>(OP_LUMA | (vg + 32)));
+                        out.push_back(static_cast<uint8_t>((vgr + 8) << 4 | (vgb + 8)));
+                    }
+                    else {
+                        out.push_back(OP_RGB);
+                        out.push_back(px.r);
+                        out.push_back(px.g);
+                        out.push_back(px.b);
+                    }
+                }
+                prev = px;
+            }
+
+            // End marker
+            out.insert(out.end(), { 0, 0, 0, 0, 0, 0, 0, 1 });
+        }
+
+        [[nodiscard]] const char* extension() const noexcept override { return "qoi"; }
+    };
+}
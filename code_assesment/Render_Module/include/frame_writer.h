@@ -0,0 +1,81 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "framebuffer.h"
+#include "frame_encoder.h"
+
+namespace Render {
+    // Back-pressure and throughput counters for an AsyncFrameWriter
+    struct FrameWriterStats {
+        uint64_t framesSubmitted = 0;
+        uint64_t framesWritten = 0;
+        uint64_t framesFailed = 0;
+        uint64_t bytesWritten = 0;
+        uint64_t producerStalls = 0;       // submits that had to wait for a free queue slot
+        double producerStallSeconds = 0.0; // total time the render thread spent waiting
+        size_t peakQueueDepth = 0;
+    };
+
+    // Bounded producer/consumer queue that encodes and writes frames on background threads
+    class AsyncFrameWriter {
+    private:
+        struct Job {
+            std::string filename;
+            int width = 0;
+            int height = 0;
+            std::vector<Color> pixels;
+            bool ready = false;   // Filled by its producer; only ready slots are published
+            bool skipped = false; // The producer's copy failed; workers drop it
+        };
+
+        std::shared_ptr<const IFrameEncoder> encoder;
+        size_t capacity;
+
+        mutable std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        std::condition_variable idle;
+        // Fixed ring of job slots; slots and workers swap jobs so pixel and filename
+        // storage circulates instead of being reallocated every frame. [head, head + queued) are
+        // published; the 'reserved' slots after them are being filled by producers outside the lock.
+        std::vector<Job> ring;
+        size_t head = 0;
+        size_t queued = 0;
+        size_t reserved = 0;
+        size_t inFlight = 0;
+        bool stopping = false;
+        FrameWriterStats stats;
+
+        std::vector<std::thread> workers;
+
+        void workerLoop();
+        [[nodiscard]] size_t publish(Job& job, bool copied) noexcept; // Caller holds 'mutex'; returns the slots published
+        void notifyPublished(size_t published) noexcept;
+        void finishJob(bool written, size_t bytes, bool counted);
+
+    public:
+        explicit AsyncFrameWriter(std::shared_ptr<const IFrameEncoder> encoder = std::make_shared<PPMEncoder>(),
+            size_t queueCapacity = 8, unsigned workerCount = 2);
+        ~AsyncFrameWriter();
+
+        AsyncFrameWriter(const AsyncFrameWriter&) = delete;
+        AsyncFrameWriter& operator=(const AsyncFrameWriter&) = delete;
+
+        // Snapshot the frame and queue it for writing; blocks while the queue is full
+        bool submit(const FrameBuffer& frame, const std::string& filename);
+
+        // Wait until every queued frame has been written
+        void flush();
+
+        [[nodiscard]] FrameWriterStats getStats() const;
+
+        [[nodiscard]] const IFrameEncoder& getEncoder() const noexcept {
+            return *encoder;
+        }
+    };
+}
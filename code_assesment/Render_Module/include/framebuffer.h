@@ -3,7 +3,10 @@
 #include <string>
 #include <fstream>
 #include <algorithm>
+#include <memory>
+#include <limits>
 #include "render_target_interface.h"
+#include "frame_encoder.h"
 
 namespace Render {
     class FrameBuffer final : public IRenderTarget {
@@ -38,21 +41,96 @@ namespace Render {
             std::fill(pixels.begin(), pixels.end(), color);
         }
 
-        bool saveToPPM(const std::string& filename) const noexcept {
-            std::ofstream file(filename, std::ios::binary);
-            if (!file) {
+        [[nodiscard]] const std::vector<Color>& getPixels() const noexcept {
+            return pixels;
+        }
+
+        // Row-major pixel storage for kernels that compute addresses themselves
+        [[nodiscard]] Color* getPixelData() noexcept {
+            return pixels.data();
+        }
+
+        // Encode the whole frame in memory and write it with a single call
+        bool saveWithEncoder(const std::string& filename, const IFrameEncoder& encoder) const noexcept {
+            try {
+                std::vector<uint8_t> encoded;
+                encoder.encode(pixels.data(), width, height, encoded);
+
+                std::ofstream file(filename, std::ios::binary);
+                if (!file) {
+                    return false;
+                }
+                file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+                return file.good();
+            }
+            catch (const std::exception&) {
                 return false;
             }
+        }
+
+        bool saveToPPM(const std::string& filename) const noexcept {
+            return saveWithEncoder(filename, PPMEncoder());
+        }
 
-            file << "P6\n" << width << " " << height << "\n255\n";
+        // Reads a binary PPM (P6, maxval 255) as written by saveToPPM; nullptr if unreadable
+        [[nodiscard]] static std::unique_ptr<FrameBuffer> loadFromPPM(const std::string& filename) noexcept {
+            try {
+                std::ifstream file(filename, std::ios::binary);
+                // Header fields are whitespace-separated and may be interleaved with '#' comments
+                const auto field = [&file](std::string& out) {
+                    while (file >> out && out[0] == '#') {
+                        file.ignore((std::numeric_limits<std::streamsize>::max)(), '\n');
+                    }
+                    return static_cast<bool>(file);
+                };
+                std::string magic, width, height, maxValue;
+                if (!field(magic) || magic != "P6" || !field(width) || !field(height) || !field(maxValue) || maxValue != "255") {
+                    return nullptr;
+                }
+                const int w = std::stoi(width);
+                const int h = std::stoi(height);
+                if (w <= 0 || h <= 0) {
+                    return nullptr;
+                }
+                file.get(); // The single whitespace byte before the pixels
 
-            for (const auto& pixel : pixels) {
-                file.write(reinterpret_cast<const char*>(&pixel.r), 1);
-                file.write(reinterpret_cast<const char*>(&pixel.g), 1);
-                file.write(reinterpret_cast<const char*>(&pixel.b), 1);
+                auto frame = std::make_unique<FrameBuffer>(w, h);
+                file.read(reinterpret_cast<char*>(frame->pixels.data()), static_cast<std::streamsize>(frame->pixels.size() * sizeof(Color)));
+                return file ? std::move(frame) : nullptr;
+            }
+            catch (const std::exception&) {
+                return nullptr;
             }
+        }
+    };
+
+    // Base for targets stored in another layout (tiled, bit-packed): the row-major output helpers are
+    // written once here against getWidth/getHeight and copyToLinear
+    class LinearConvertibleTarget : public IRenderTarget, public ILinearConvertible {
+    public:
+        // Copy into a row-major FrameBuffer of the same size (e.g. for a frame writer or the window);
+        // returns false if the sizes differ
+        bool copyTo(FrameBuffer& target) const noexcept {
+            if (target.getWidth() != getWidth() || target.getHeight() != getHeight()) {
+                return false;
+            }
+            copyToLinear(target.getPixelData());
+            return true;
+        }
 
-            return file.good();
+        bool saveWithEncoder(const std::string& filename, const IFrameEncoder& encoder) const noexcept {
+            try {
+                FrameBuffer linear(getWidth(), getHeight());
+                copyToLinear(linear.getPixelData());
+                return linear.saveWithEncoder(filename, encoder);
+            }
+            catch (const std::exception&) {
+                return false;
+            }
+        }
+
+        bool saveToPPM(const std::string& filename) const noexcept {
+            return saveWithEncoder(filename, PPMEncoder());
         }
     };
 }
\ No newline at end of file
@@ -2,8 +2,10 @@
 #include <cmath>
 #include <algorithm>
 #include <utility>
+#include <cstdint>
 #include "Vector2D.h"
 #include "render_target_interface.h"
+#include "depth_buffer.h"
 
 namespace Render {
     namespace GraphicsPrimitives {
@@ -38,6 +40,171 @@ namespace Render {
             }
         }
 
+        // Blend 'color' over the existing pixel with 8-bit coverage (255 = opaque)
+        inline void blendPixel(IRenderTarget& target, int x, int y, const Color& color, int coverage) noexcept {
+            if (coverage <= 0) return;
+            if (coverage >= 255) {
+                target.setPixel(x, y, color);
+                return;
+            }
+
+            const Color dst = target.getPixel(x, y);
+            const auto mix = [coverage](int d, int s) noexcept {
+                // d + (s - d) * coverage / 255 rounded to nearest, without a divide or a branch. With
+                // t = m + 128, (t + (t >> 8)) >> 8 rounds m / 255 exactly for 0 <= m <= 255 * 255; it is
+                // applied to the magnitude and the sign restored, since >> floors negative values.
+                const int x = (s - d) * coverage;
+                const int sign = x >> 31; // 0 or -1
+                const int t = ((x ^ sign) - sign) + 128;
+                const int q = (t + (t >> 8)) >> 8;
+                return static_cast<uint8_t>(d + ((q ^ sign) - sign));
+            };
+            target.setPixel(x, y, Color(mix(dst.r, color.r), mix(dst.g, color.g), mix(dst.b, color.b)));
+        }
+
+        // 16.16 minor coordinate of a Wu line at major step 'major', computed exactly rather than by
+        // accumulating the rounded gradient, which drifts by up to a pixel per 65536 skipped steps
+        [[nodiscard]] inline int64_t wuIntercept(int x0, int y0, int dx, int dy, int major) noexcept {
+            const int64_t offset = static_cast<int64_t>(dy) * (static_cast<int64_t>(major) - x0);
+            const int64_t whole = offset / dx;
+            return ((static_cast<int64_t>(y0) + whole) << 16) + ((offset - whole * dx) << 16) / dx;
+        }
+
+        // Xiaolin Wu's anti-aliased line with a 16.16 fixed-point minor-axis accumulator
+        inline void drawLineAA(IRenderTarget& target, int x0, int y0, int x1, int y1, const Color& color) noexcept {
+            const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+
+            if (steep) {
+                std::swap(x0, y0);
+                std::swap(x1, y1);
+            }
+
+            if (x0 > x1) {
+                std::swap(x0, x1);
+                std::swap(y0, y1);
+            }
+
+            const int dx = x1 - x0;
+            const int dy = y1 - y0;
+
+            // Endpoints sit on pixel centres, so they are fully covered
+            steep ? target.setPixel(y0, x0, color) : target.setPixel(x0, y0, color);
+            if (dx == 0) return;
+            steep ? target.setPixel(y1, x1, color) : target.setPixel(x1, y1, color);
+
+            // 64-bit so a minor coordinate beyond 16 bits cannot overflow the fixed-point accumulator.
+            // The walk is clipped to the target along the major axis; off-screen steps draw nothing.
+            const int64_t gradient = (static_cast<int64_t>(dy) << 16) / dx;
+            const int first = std::max(x0 + 1, 0);
+            const int last = std::min(x1 - 1, (steep ? target.getHeight() : target.getWidth()) - 1);
+            int64_t intery = wuIntercept(x0, y0, dx, dy, first);
+
+            for (int x = first; x <= last; ++x) {
+                const int y = static_cast<int>(intery >> 16);
+                const int coverage = static_cast<int>((intery >> 8) & 0xFF);
+
+                if (steep) {
+                    blendPixel(target, y, x, color, 255 - coverage);
+                    blendPixel(target, y + 1, x, color, coverage);
+                }
+                else {
+                    blendPixel(target, x, y, color, 255 - coverage);
+                    blendPixel(target, x, y + 1, color, coverage);
+                }
+                intery += gradient;
+            }
+        }
+
+        // Bresenham line that only writes pixels passing the depth test
+        inline void drawLineDepthTested(IRenderTarget& target, const DepthBuffer& depthBuffer,
+            int x0, int y0, float z0, int x1, int y1, float z1, const Color& color, float bias) noexcept {
+            bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+
+            if (steep) {
+                std::swap(x0, y0);
+                std::swap(x1, y1);
+            }
+
+            if (x0 > x1) {
+                std::swap(x0, x1);
+                std::swap(y0, y1);
+                std::swap(z0, z1);
+            }
+
+            int dx = x1 - x0;
+            int dy = std::abs(y1 - y0);
+            int error = dx / 2;
+            int yStep = (y0 < y1) ? 1 : -1;
+            int y = y0;
+            const float zStep = (dx > 0) ? (z1 - z0) / static_cast<float>(dx) : 0.0f;
+            float z = z0;
+
+            for (int x = x0; x <= x1; ++x) {
+                if (steep) {
+                    if (depthBuffer.isVisible(y, x, z, bias)) target.setPixel(y, x, color);
+                }
+                else {
+                    if (depthBuffer.isVisible(x, y, z, bias)) target.setPixel(x, y, color);
+                }
+
+                z += zStep;
+                error -= dy;
+                if (error < 0) {
+                    y += yStep;
+                    error += dx;
+                }
+            }
+        }
+
+        // Wu line with the depth test applied to each coverage sample
+        inline void drawLineAADepthTested(IRenderTarget& target, const DepthBuffer& depthBuffer,
+            int x0, int y0, float z0, int x1, int y1, float z1, const Color& color, float bias) noexcept {
+            const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+
+            if (steep) {
+                std::swap(x0, y0);
+                std::swap(x1, y1);
+            }
+
+            if (x0 > x1) {
+                std::swap(x0, x1);
+                std::swap(y0, y1);
+                std::swap(z0, z1);
+            }
+
+            const auto plot = [&](int major, int minor, float z, int coverage) noexcept {
+                const int px = steep ? minor : major;
+                const int py = steep ? major : minor;
+                if (depthBuffer.isVisible(px, py, z, bias)) {
+                    blendPixel(target, px, py, color, coverage);
+                }
+            };
+
+            const int dx = x1 - x0;
+            const int dy = y1 - y0;
+
+            plot(x0, y0, z0, 255);
+            if (dx == 0) return;
+            plot(x1, y1, z1, 255);
+
+            // Same 64-bit accumulator and major-axis clipping as drawLineAA
+            const int64_t gradient = (static_cast<int64_t>(dy) << 16) / dx;
+            const int first = std::max(x0 + 1, 0);
+            const int last = std::min(x1 - 1, (steep ? target.getHeight() : target.getWidth()) - 1);
+            int64_t intery = wuIntercept(x0, y0, dx, dy, first);
+            const float zStep = (z1 - z0) / static_cast<float>(dx);
+            float z = z0 + zStep * static_cast<float>(first - x0);
+
+            for (int x = first; x <= last; ++x) {
+                const int y = static_cast<int>(intery >> 16);
+                const int coverage = static_cast<int>((intery >> 8) & 0xFF);
+                plot(x, y, z, 255 - coverage);
+                plot(x, y + 1, z, coverage);
+                intery += gradient;
+                z += zStep;
+            }
+        }
+
         // Midpoint circle algorithm with filling
         inline void drawCircle(IRenderTarget& target, int centerX, int centerY, int radius, const Color& color) noexcept {
             // Fill circle
@@ -50,6 +217,84 @@ namespace Render {
             }
         }
 
+        // drawLine restricted to the rows [bandTop, bandTop + target height), written with y relative to
+        // bandTop. Produces exactly drawLine's pixels in those rows, but the Bresenham state is computed
+        // at the first in-band step, so only the in-band part of the line is walked.
+        inline void drawLineInBand(IRenderTarget& target, int bandTop, int x0, int y0, int x1, int y1, const Color& color) noexcept {
+            const int64_t bandEnd = static_cast<int64_t>(bandTop) + target.getHeight(); // Exclusive
+            const bool steep = std::abs(y1 - y0) > std::abs(x1 - x0);
+
+            if (steep) {
+                std::swap(x0, y0);
+                std::swap(x1, y1);
+            }
+
+            if (x0 > x1) {
+                std::swap(x0, x1);
+                std::swap(y0, y1);
+            }
+
+            const int64_t dx = static_cast<int64_t>(x1) - x0;
+            const int64_t dy = std::abs(static_cast<int64_t>(y1) - y0);
+            const int64_t half = dx / 2; // drawLine's initial error
+            const int yStep = (y0 < y1) ? 1 : -1;
+
+            // Major-axis steps [kBegin, kEnd] and the last minor-axis step count that is still in the band
+            int64_t kBegin = 0;
+            int64_t kEnd = dx;
+            int64_t nLast = dy;
+            if (steep) {
+                kBegin = std::max<int64_t>(kBegin, bandTop - static_cast<int64_t>(x0));
+                kEnd = std::min<int64_t>(kEnd, bandEnd - 1 - x0);
+            }
+            else {
+                const int64_t nFirst = (yStep > 0) ? bandTop - static_cast<int64_t>(y0) : y0 - (bandEnd - 1);
+                nLast = (yStep > 0) ? bandEnd - 1 - y0 : y0 - static_cast<int64_t>(bandTop);
+                if (nLast < 0 || nFirst > dy) return;
+                // First step after which at least nFirst minor steps have been taken
+                if (nFirst > 0) {
+                    kBegin = ((nFirst - 1) * dx + half) / dy + 1;
+                }
+            }
+            if (kBegin > kEnd) return;
+
+            // After k steps drawLine has taken n = ceil((k * dy - half) / dx) minor steps (0 if negative)
+            const int64_t t = kBegin * dy - half;
+            int64_t n = (t <= 0) ? 0 : (t + dx - 1) / dx;
+            int64_t error = half - kBegin * dy + n * dx;
+            int y = static_cast<int>(y0 + yStep * n);
+
+            for (int64_t k = kBegin; k <= kEnd && n <= nLast; ++k) {
+                const int x = static_cast<int>(x0 + k);
+                steep ? target.setPixel(y, x - bandTop, color) : target.setPixel(x, y - bandTop, color);
+
+                error -= dy;
+                if (error < 0) {
+                    y += yStep;
+                    error += dx;
+                    ++n;
+                }
+            }
+        }
+
+        // drawCircle restricted to the rows [bandTop, bandTop + target height), written relative to bandTop
+        inline void drawCircleInBand(IRenderTarget& target, int bandTop, int centerX, int centerY, int radius, const Color& color) noexcept {
+            const int yBegin = std::max(-radius, bandTop - centerY);
+            const int yEnd = std::min(radius, bandTop + target.getHeight() - 1 - centerY);
+            for (int y = yBegin; y <= yEnd; y++) {
+                for (int x = -radius; x <= radius; x++) {
+                    if (x * x + y * y <= radius * radius) {
+                        target.setPixel(centerX + x, centerY + y - bandTop, color);
+                    }
+                }
+            }
+        }
+
+        // Continuous screen position matching worldToScreen before truncation
+        [[nodiscard]] inline Math::Vector2D worldToScreenF(const Math::Vector2D& point, int width, int height) noexcept {
+            return Math::Vector2D((point.x + 1.0f) * width / 2.0f, (1.0f - point.y) * height / 2.0f);
+        }
+
         // Convert from world to screen coordinates
         [[nodiscard]] inline std::pair<int, int> worldToScreen(const Math::Vector2D& point, int width, int height) noexcept {
             return {
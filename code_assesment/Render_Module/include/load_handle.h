@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include "wireframe.h"
+
+namespace Render {
+    // Thrown by a load that stopped because cancellation was requested
+    class LoadCancelled : public std::runtime_error {
+    public:
+        LoadCancelled() : std::runtime_error("Load cancelled") {}
+    };
+
+    // Point-in-time view of a load
+    struct LoadProgress {
+        uint64_t bytesRead = 0;
+        uint64_t totalBytes = 0; // 0 when the size is unknown
+        size_t verticesParsed = 0;
+        size_t facesParsed = 0;
+
+        [[nodiscard]] float fraction() const noexcept {
+            return totalBytes ? static_cast<float>(static_cast<double>(bytesRead) / static_cast<double>(totalBytes)) : 0.0f;
+        }
+    };
+
+    // Progress and cancellation state shared between a loader and whoever is waiting on it.
+    // The loader publishes progress every few hundred elements and polls for cancellation at the same points.
+    class LoadControl {
+    private:
+        std::atomic<uint64_t> bytesRead{ 0 };
+        std::atomic<uint64_t> totalBytes{ 0 };
+        std::atomic<size_t> verticesParsed{ 0 };
+        std::atomic<size_t> facesParsed{ 0 };
+        std::atomic<bool> cancelRequested{ false };
+
+    public:
+        void setTotalBytes(uint64_t bytes) noexcept {
+            totalBytes.store(bytes, std::memory_order_relaxed);
+        }
+
+        void report(uint64_t bytes, size_t vertices, size_t faces) noexcept {
+            bytesRead.store(bytes, std::memory_order_relaxed);
+            verticesParsed.store(vertices, std::memory_order_relaxed);
+            facesParsed.store(faces, std::memory_order_relaxed);
+        }
+
+        void requestCancel() noexcept {
+            cancelRequested.store(true, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool isCancelRequested() const noexcept {
+            return cancelRequested.load(std::memory_order_relaxed);
+        }
+
+        void throwIfCancelled() const {
+            if (isCancelRequested()) {
+                throw LoadCancelled();
+            }
+        }
+
+        [[nodiscard]] LoadProgress getProgress() const noexcept {
+            LoadProgress progress;
+            progress.bytesRead = bytesRead.load(std::memory_order_relaxed);
+            progress.totalBytes = totalBytes.load(std::memory_order_relaxed);
+            progress.verticesParsed = verticesParsed.load(std::memory_order_relaxed);
+            progress.facesParsed = facesParsed.load(std::memory_order_relaxed);
+            return progress;
+        }
+    };
+
+    // Handle to a background load. The finished object is handed over in one step by get()/tryTake(),
+    // so callers never observe a partially built object. Destroying a pending handle cancels the load
+    // and waits for the worker to stop.
+    class LoadHandle {
+    private:
+        std::shared_ptr<LoadControl> control;
+        std::future<std::unique_ptr<WireframeObject>> result;
+
+    public:
+        LoadHandle(std::shared_ptr<LoadControl> control, std::future<std::unique_ptr<WireframeObject>> result) noexcept
+            : control(std::move(control)), result(std::move(result)) {
+        }
+
+        ~LoadHandle() {
+            if (result.valid()) {
+                cancel();
+                result.wait();
+            }
+        }
+
+        LoadHandle(const LoadHandle&) = delete;
+        LoadHandle& operator=(const LoadHandle&) = delete;
+        LoadHandle(LoadHandle&&) noexcept = default;
+        LoadHandle& operator=(LoadHandle&&) noexcept = delete;
+
+        [[nodiscard]] LoadProgress getProgress() const noexcept {
+            return control ? control->getProgress() : LoadProgress{};
+        }
+
+        // Cooperative: the loader stops at its next progress point and get() throws LoadCancelled
+        void cancel() noexcept {
+            if (control) control->requestCancel();
+        }
+
+        [[nodiscard]] bool isCancelRequested() const noexcept {
+            return control && control->isCancelRequested();
+        }
+
+        // True once get() will not block (including when the result was already taken)
+        [[nodiscard]] bool isReady() const {
+            return !result.valid() || result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        void wait() const {
+            if (result.valid()) result.wait();
+        }
+
+        // Blocks until the load finishes; rethrows load errors (LoadCancelled after cancel()). Single use.
+        [[nodiscard]] std::unique_ptr<WireframeObject> get() {
+            if (!result.valid()) {
+                throw std::logic_error("Load result already taken");
+            }
+            return result.get();
+        }
+
+        // Non-blocking hand-over: when the load has finished, swaps the object into 'target' and returns true
+        bool tryTake(std::unique_ptr<WireframeObject>& target) {
+            if (!result.valid() || !isReady()) return false;
+            std::unique_ptr<WireframeObject> loaded = result.get();
+            target.swap(loaded);
+            return true;
+        }
+    };
+}
\ No newline at end of file
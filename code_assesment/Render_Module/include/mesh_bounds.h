@@ -0,0 +1,52 @@
+#pragma once
+#include <span>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include "bounds.h"
+#include "vertex.h"
+
+namespace Render {
+    struct MeshBounds {
+        Math::BoundingBox box;
+        Math::BoundingSphere sphere; // Centred on the box, radius to the farthest vertex
+    };
+
+    // Vertices per worker below which the reduction stays on the calling thread
+    inline constexpr size_t BoundsChunkVertices = size_t{ 1 } << 16;
+
+    // Two SSE2 passes (min/max, then farthest distance from the box centre), split across threads
+    // for large meshes. Non-finite positions are not filtered.
+    [[nodiscard]] MeshBounds computeMeshBounds(std::span<const Vertex> vertices);
+
+    // Lazily computed bounds keyed on a mesh revision (see MeshChangeLog). Safe to query from
+    // several threads sharing a const mesh; copies start empty.
+    class MeshBoundsCache {
+    private:
+        mutable std::mutex mutex;
+        MeshBounds bounds;
+        uint64_t meshId = 0;
+        uint64_t revision = 0;
+
+    public:
+        MeshBoundsCache() noexcept = default;
+        MeshBoundsCache(const MeshBoundsCache&) noexcept {}
+        MeshBoundsCache& operator=(const MeshBoundsCache&) noexcept {
+            std::lock_guard<std::mutex> lock(mutex);
+            meshId = 0;
+            return *this;
+        }
+
+        // Returns the cached bounds, or computes them with 'compute' when (id, rev) changed
+        template <typename Compute>
+        [[nodiscard]] MeshBounds get(uint64_t id, uint64_t rev, Compute&& compute) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (meshId != id || revision != rev) {
+                bounds = compute();
+                meshId = id;
+                revision = rev;
+            }
+            return bounds;
+        }
+    };
+}
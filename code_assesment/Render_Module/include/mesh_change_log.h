@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Render {
+    enum class MeshChangeKind {
+        VerticesAppended, // [begin, end) are new vertices
+        VerticesUpdated,  // Positions in [begin, end) changed
+        VerticesRemoved,  // [begin, end) were erased; later vertices shifted down and edges/faces were renumbered
+        EdgesAppended,    // [begin, end) are new edges
+        EdgesRemoved,     // [begin, end) were erased; later edges shifted down
+        FacesAppended,    // [begin, end) are new faces
+        Reset             // Anything may have changed (e.g. the object was assigned from another one)
+    };
+
+    struct MeshChange {
+        uint64_t revision;
+        MeshChangeKind kind;
+        std::size_t begin, end; // Index range at the time of the change
+    };
+
+    // Bounded history of edits to one mesh, so caches derived from it (transformed positions, bounds,
+    // spatial indices) can catch up by redoing only the affected ranges. Consecutive appends and
+    // overlapping/adjacent updates are merged, so a reported range may also cover changes the consumer
+    // already applied; consumers must apply ranges idempotently.
+    class MeshChangeLog {
+    private:
+        static constexpr std::size_t Capacity = 64;
+
+        std::vector<MeshChange> entries; // Oldest first
+        uint64_t revision = 0;
+        uint64_t droppedThrough = 0; // Changes up to this revision are no longer listed
+        uint64_t meshId;
+
+        [[nodiscard]] static uint64_t nextMeshId() noexcept {
+            static std::atomic<uint64_t> counter{ 0 };
+            return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        [[nodiscard]] static bool isAppend(MeshChangeKind kind) noexcept {
+            return kind == MeshChangeKind::VerticesAppended || kind == MeshChangeKind::EdgesAppended ||
+                kind == MeshChangeKind::FacesAppended;
+        }
+
+    public:
+        MeshChangeLog() noexcept : meshId(nextMeshId()) {}
+
+        // A copy is a different mesh as far as consumers are concerned
+        MeshChangeLog(const MeshChangeLog& other)
+            : entries(other.entries), revision(other.revision), droppedThrough(other.droppedThrough), meshId(nextMeshId()) {
+        }
+
+        MeshChangeLog& operator=(const MeshChangeLog& other) {
+            if (this != &other) {
+                entries = other.entries;
+                revision = other.revision;
+                droppedThrough = other.droppedThrough;
+                meshId = nextMeshId();
+            }
+            return *this;
+        }
+
+        // A move hands the identity over; the moved-from log becomes a new, empty mesh
+        MeshChangeLog(MeshChangeLog&& other) noexcept
+            : entries(std::move(other.entries)), revision(other.revision), droppedThrough(other.droppedThrough),
+            meshId(std::exchange(other.meshId, nextMeshId())) {
+            other.entries.clear();
+            other.revision = other.droppedThrough = 0;
+        }
+
+        MeshChangeLog& operator=(MeshChangeLog&& other) noexcept {
+            if (this != &other) {
+                entries = std::move(other.entries);
+                revision = other.revision;
+                droppedThrough = other.droppedThrough;
+                meshId = std::exchange(other.meshId, nextMeshId());
+                other.entries.clear();
+                other.revision = other.droppedThrough = 0;
+            }
+            return *this;
+        }
+
+        // Never throws: if the history cannot grow, it is cut so consumers rebuild instead
+        void record(MeshChangeKind kind, std::size_t begin, std::size_t end) noexcept {
+            if (begin >= end && kind != MeshChangeKind::Reset) return;
+            ++revision;
+
+            if (!entries.empty()) {
+                MeshChange& last = entries.back();
+                const bool mergeAppend = isAppend(kind) && last.kind == kind && last.end == begin;
+                const bool mergeUpdate = kind == MeshChangeKind::VerticesUpdated && last.kind == kind &&
+                    begin <= last.end && last.begin <= end;
+                if (mergeAppend || mergeUpdate) {
+                    last.begin = (last.begin < begin) ? last.begin : begin;
+                    last.end = (last.end > end) ? last.end : end;
+                    last.revision = revision;
+                    return;
+                }
+            }
+
+            if (entries.size() == Capacity) {
+                droppedThrough = entries.front().revision;
+                entries.erase(entries.begin());
+            }
+            try {
+                entries.push_back(MeshChange{ revision, kind, begin, end });
+            }
+            catch (...) {
+                entries.clear();
+                droppedThrough = revision;
+            }
+        }
+
+        [[nodiscard]] uint64_t getRevision() const noexcept {
+            return revision;
+        }
+
+        // Identifies the mesh; copies get a new id, moves keep it
+        [[nodiscard]] uint64_t getMeshId() const noexcept {
+            return meshId;
+        }
+
+        // Calls fn(const MeshChange&) for the changes after 'since', oldest first. Returns false (without
+        // calling fn) when the history no longer reaches back that far and the consumer must rebuild.
+        template <typename Fn>
+        bool forEachSince(uint64_t since, Fn&& fn) const {
+            if (since < droppedThrough || since > revision) return false;
+            for (const auto& change : entries) {
+                if (change.revision > since) fn(change);
+            }
+            return true;
+        }
+    };
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "wireframe.h"
+
+namespace Render {
+    // Parametric meshes for benchmarks and stress tests, from a few hundred to hundreds of millions of
+    // elements. Every element is computed from its index alone, so vertices, edges and faces are written
+    // in parallel straight into the object's storage (see WireframeObject::assignGenerated); results do
+    // not depend on the thread count. Faces are optional because they are only needed for hidden-line
+    // removal and cost 24 bytes each. Invalid parameters throw std::invalid_argument.
+    namespace MeshGenerators {
+        // 'rings' latitude bands (>= 2) by 'segments' longitude steps (>= 3), poles on +-Y.
+        // Vertices: (rings - 1) * segments + 2, edges: (2 * rings - 1) * segments.
+        [[nodiscard]] std::unique_ptr<WireframeObject> uvSphere(int rings, int segments, float radius = 1.0f, bool withFaces = false);
+
+        // Ring of 'rings' (>= 3) tube sections of 'sides' (>= 3) vertices around the Y axis.
+        // Vertices: rings * sides, edges: 2 * rings * sides.
+        [[nodiscard]] std::unique_ptr<WireframeObject> torus(int rings, int sides, float majorRadius = 1.0f,
+            float minorRadius = 0.35f, bool withFaces = false);
+
+        // 'columns' x 'rows' cells (>= 1 each) in the XY plane, centred on the origin, 'size' across the wider side.
+        // Vertices: (columns + 1) * (rows + 1), edges: columns * (rows + 1) + rows * (columns + 1).
+        [[nodiscard]] std::unique_ptr<WireframeObject> grid(int columns, int rows, float size = 2.0f, bool withFaces = false);
+
+        // 'count' points, no edges, uniform in the cube [-halfExtent, halfExtent]^3; the same seed gives the same cloud
+        [[nodiscard]] std::unique_ptr<WireframeObject> pointCloud(std::size_t count, uint64_t seed = 1, float halfExtent = 1.0f);
+
+        // Icosahedron with each face split 4^subdivisions ways (0..13) and every vertex pushed onto the sphere.
+        // Connectivity matches repeated midpoint subdivision; positions come from each face's flat lattice.
+        // With n = 2^subdivisions: vertices 10n^2 + 2, edges 30n^2, faces 20n^2.
+        [[nodiscard]] std::unique_ptr<WireframeObject> icosphere(int subdivisions, float radius = 1.0f, bool withFaces = false);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "wireframe.h"
+#include "load_handle.h"
+
+namespace Render {
+    // Collects polygons into a WireframeObject: faces are fan-triangulated for hidden-line removal and
+    // each polygon's boundary edges are deduplicated (an edge shared by two faces is stored once).
+    // Edges are added in sorted order by finish(), so every format yields the same edge list for the same mesh.
+    class MeshBuilder {
+    private:
+        WireframeObject& object;
+        std::vector<uint64_t> edgeKeys; // (lower index << 32) | higher index
+
+        void addEdgeKey(size_t a, size_t b);
+
+    public:
+        explicit MeshBuilder(WireframeObject& object) noexcept : object(object) {}
+
+        void reserve(size_t vertexCount, size_t faceCount);
+
+        void addVertex(const Vertex& vertex) {
+            object.addVertex(vertex);
+        }
+
+        [[nodiscard]] size_t getVertexCount() const noexcept {
+            return object.getVertices().size();
+        }
+
+        void addTriangle(size_t a, size_t b, size_t c);
+        void addPolygon(std::span<const size_t> indices);
+        void addPolyline(std::span<const size_t> indices);
+
+        // Sorts, deduplicates and stores the edges
+        void finish();
+    };
+
+    // Format readers; each streams into 'object' without normalizing it and throws std::runtime_error on
+    // malformed input. 'control' (optional) receives progress and can cancel with LoadCancelled.
+    namespace MeshReaders {
+        // Binary STL: triangles are read in bulk blocks and coincident corners are welded by exact position
+        void readBinarySTL(const std::string& filename, WireframeObject& object, LoadControl* control);
+
+        // Binary PLY (little or big endian): fixed-size vertex records are read in bulk and x/y/z picked
+        // out by offset; face lists may hold polygons of any size
+        void readBinaryPLY(const std::string& filename, WireframeObject& object, LoadControl* control);
+
+        // Wavefront OBJ: v, f and l statements; f accepts v, v/vt, v//vn and v/vt/vn with negative indices
+        void readOBJ(const std::string& filename, WireframeObject& object, LoadControl* control);
+    }
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <span>
+#include <cstdint>
+#include "framebuffer.h"
+#include "subpixel_line.h"
+
+namespace Render {
+    namespace GraphicsPrimitives {
+        // Screen-space line endpoints; integer pixels or 24.8 fixed point depending on the consumer
+        struct LineSegment {
+            int x0, y0, x1, y1;
+        };
+
+        struct MultiLineResult {
+            uint64_t pixelsWritten = 0;
+            uint64_t pixelsClipped = 0; // Minor-axis writes that fell outside the target
+        };
+
+        // Lines covering at most this many major-axis pixels are rasterized in SIMD lanes
+        inline constexpr int ShortLineMaxPixels = 32;
+
+        // Lines processed together: two 4-lane SSE2 registers
+        inline constexpr int MultiLineLanes = 8;
+
+        // Draws many 24.8 fixed-point lines straight into a frame buffer. Short lines are stepped
+        // MultiLineLanes at a time with pixel addresses computed in vector registers and written by a
+        // scalar scatter; longer lines use the scalar DDA. Pixels match drawLineSubPixel exactly.
+        MultiLineResult drawLinesSubPixel(FrameBuffer& target, std::span<const LineSegment> segments, const Color& color) noexcept;
+    }
+}
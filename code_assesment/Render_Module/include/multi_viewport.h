@@ -0,0 +1,138 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include "render_target_interface.h"
+#include "framebuffer.h"
+#include "renderer.h"
+#include "transformed_object_cache.h"
+#include "matrix4x4.h"
+
+namespace Render {
+    // Clipped window onto a rectangle of another target; pixel (0, 0) is the rectangle's top-left.
+    // Windows onto disjoint rectangles of one FrameBuffer can be drawn from different threads.
+    class ViewportTarget final : public IRenderTarget {
+    private:
+        std::shared_ptr<IRenderTarget> inner;
+        FrameBuffer* direct; // Set when 'inner' is a FrameBuffer, for row fills
+        int originX, originY;
+        int width, height;
+
+    public:
+        // The rectangle is clipped to the inner target
+        ViewportTarget(std::shared_ptr<IRenderTarget> target, int x, int y, int w, int h) noexcept
+            : inner(std::move(target)), direct(dynamic_cast<FrameBuffer*>(inner.get())) {
+            originX = std::clamp(x, 0, inner->getWidth());
+            originY = std::clamp(y, 0, inner->getHeight());
+            width = std::clamp(w, 0, inner->getWidth() - originX);
+            height = std::clamp(h, 0, inner->getHeight() - originY);
+        }
+
+        void setPixel(int x, int y, const Color& color) noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                inner->setPixel(originX + x, originY + y, color);
+            }
+        }
+
+        [[nodiscard]] Color getPixel(int x, int y) const noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                return inner->getPixel(originX + x, originY + y);
+            }
+            return Color::Black();
+        }
+
+        [[nodiscard]] int getWidth() const noexcept override { return width; }
+        [[nodiscard]] int getHeight() const noexcept override { return height; }
+
+        // Clears only the rectangle
+        void clear(const Color& color = Color::Black()) noexcept override {
+            if (direct) {
+                const int stride = direct->getWidth();
+                for (int y = 0; y < height; ++y) {
+                    Color* row = direct->getPixelData() + static_cast<size_t>(originY + y) * stride + originX;
+                    std::fill(row, row + width, color);
+                }
+                return;
+            }
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    inner->setPixel(originX + x, originY + y, color);
+                }
+            }
+        }
+    };
+
+    struct Viewport {
+        std::shared_ptr<IRenderTarget> target; // A whole target or a ViewportTarget
+        ViewTransform camera;
+        LineMode lineMode = LineMode::Aliased;
+        bool hiddenLines = false;
+        int vertexRadius = 3;
+        Color color = Color::Blue();
+        Color background = Color::Black();
+    };
+
+    // Draws one object from several cameras. The object is transformed into world space once per
+    // frame (incrementally, through TransformedObjectCache); each viewport then applies its camera
+    // during projection, so no viewport copies or re-transforms the mesh. Viewports are drawn in
+    // parallel, each with its own Renderer (arena, depth buffer), so their targets must not overlap.
+    class MultiViewportRenderer {
+    private:
+        struct Slot {
+            Viewport viewport;
+            std::unique_ptr<Renderer> renderer;
+        };
+
+        std::vector<Slot> slots;
+        TransformedObjectCache world;
+
+        // May throw (endFrame, stats); draw() rethrows it
+        void drawSlot(Slot& slot, const WireframeObject& object);
+
+    public:
+        // Returns the viewport's index
+        size_t addViewport(Viewport viewport);
+
+        void clearViewports() noexcept {
+            slots.clear();
+        }
+
+        [[nodiscard]] size_t getViewportCount() const noexcept {
+            return slots.size();
+        }
+
+        // Camera, line mode and colours may be changed between frames; the target may not
+        [[nodiscard]] Viewport& getViewport(size_t index) noexcept {
+            return slots[index].viewport;
+        }
+
+        // Transform 'object' by 'model' into world space; only changed ranges are redone
+        const WireframeObject& update(const WireframeObject& object, const Math::Matrix4x4& model) {
+            world.update(object, model);
+            return world.get();
+        }
+
+        // Draw the world-space object into every viewport. If a viewport throws, the exception is
+        // rethrown once every viewport has finished
+        void draw();
+
+        // As draw(), for an object that is already in world space (an identity model), so it is
+        // projected straight from the source without a cached copy
+        void draw(const WireframeObject& worldObject);
+
+        void render(const WireframeObject& object, const Math::Matrix4x4& model) {
+            update(object, model);
+            draw();
+        }
+
+        // The world-space object drawn by the last draw()
+        [[nodiscard]] const WireframeObject& getWorldObject() const noexcept {
+            return world.get();
+        }
+
+        // Orthographic cameras looking at the origin from 'distance' along +Z, +X and +Y
+        [[nodiscard]] static Math::Matrix4x4 frontView(float distance) noexcept;
+        [[nodiscard]] static Math::Matrix4x4 sideView(float distance) noexcept;
+        [[nodiscard]] static Math::Matrix4x4 topView(float distance) noexcept;
+    };
+}
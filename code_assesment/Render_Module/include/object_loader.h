@@ -7,10 +7,16 @@
 #include <limits>
 #include <functional>
 #include <algorithm>
+#include <cctype>
 #include <stdexcept>
+#include <filesystem>
+#include <future>
 #include "wireframe.h"
 #include "vector3D.h"
 #include "matrix4x4.h"
+#include "trace.h"
+#include "load_handle.h"
+#include "mesh_readers.h"
 
 #undef max
 #undef min
@@ -21,38 +27,42 @@ namespace Render {
         std::map<int, size_t> vertexMap;
         std::function<std::unique_ptr<WireframeObject>()> objectFactory; // Injected factory
 
-        void normalizeObject(std::unique_ptr<WireframeObject>& object) const noexcept {
-            if (!object || object->getVertices().empty()) return;
+        // Elements parsed between progress reports and cancellation checks
+        static constexpr size_t ProgressInterval = 256;
 
-            const auto& vertices = object->getVertices();
-            Math::Vector3D min{ std::numeric_limits<float>::max(),
-                                std::numeric_limits<float>::max(),
-                                std::numeric_limits<float>::max() };
-            Math::Vector3D max{ std::numeric_limits<float>::lowest(),
-                                std::numeric_limits<float>::lowest(),
-                                std::numeric_limits<float>::lowest() };
-
-            for (const auto& vertex : vertices) {
-                const auto& pos = vertex.getPosition();
-                min.x = std::min(min.x, pos.x);
-                min.y = std::min(min.y, pos.y);
-                min.z = std::min(min.z, pos.z);
-                max.x = std::max(max.x, pos.x);
-                max.y = std::max(max.y, pos.y);
-                max.z = std::max(max.z, pos.z);
-            }
+        using LoadMethod = std::unique_ptr<WireframeObject>(ObjectLoader::*)(const std::string&, LoadControl*);
+
+        // Runs one of the load methods on a background thread with a copy of this loader's factory
+        [[nodiscard]] LoadHandle startAsync(const std::string& filename, LoadMethod method) const {
+            auto control = std::make_shared<LoadControl>();
+            auto future = std::async(std::launch::async, [filename, method, factory = objectFactory, control]() {
+                RENDER_TRACE_THREAD_NAME("loader");
+                ObjectLoader loader(factory);
+                return (loader.*method)(filename, control.get());
+            });
+            return LoadHandle(control, std::move(future));
+        }
 
-            Math::Vector3D center(
-                (min.x + max.x) / 2.0f,
-                (min.y + max.y) / 2.0f,
-                (min.z + max.z) / 2.0f
-            );
+        template <typename Read>
+        [[nodiscard]] std::unique_ptr<WireframeObject> loadWith(Read&& read, LoadControl* control) {
+            auto object = objectFactory();
+            read(*object);
+            if (control) control->throwIfCancelled();
+            normalizeObject(object);
+            return object;
+        }
+
+        void normalizeObject(std::unique_ptr<WireframeObject>& object) const {
+            RENDER_TRACE_SCOPE("ObjectLoader::normalizeObject");
+            if (!object || object->getVertices().empty()) return;
 
-            float maxDim = std::max({ max.x - min.x, max.y - min.y, max.z - min.z });
-            float scale = 2.0f / maxDim; // Scale to fit in [-1,1] cube
+            // Scale to fit in the [-1,1] cube, centred on the origin
+            const Math::BoundingBox box = object->getBoundingBox();
+            const Math::Vector3D center = box.center();
+            const float maxDim = box.maxDimension();
+            const float scale = (maxDim > 0.0f) ? 2.0f / maxDim : 1.0f;
 
-            object->transform(Math::Matrix4x4::createTranslation(-center.x, -center.y, -center.z));
-            object->transform(Math::Matrix4x4::createScale(scale, scale, scale));
+            object->offsetAndScale(Math::Vector3D(-center.x, -center.y, -center.z), scale);
         }
 
     public:
@@ -62,16 +72,46 @@ namespace Render {
         }
 
             [[nodiscard]] std::unique_ptr<WireframeObject> loadFromCSV(const std::string& filename) {
-                std::ifstream file(filename);
+                return loadFromCSV(filename, nullptr);
+            }
+
+            // As above, publishing progress to 'control' and stopping with LoadCancelled when it is cancelled
+            [[nodiscard]] std::unique_ptr<WireframeObject> loadFromCSV(const std::string& filename, LoadControl* control) {
+                RENDER_TRACE_SCOPE("ObjectLoader::loadFromCSV");
+                // Binary, so CRLF files count their real bytes; readLine strips the '\r'
+                std::ifstream file(filename, std::ios::binary);
                 if (!file.is_open()) {
                     throw std::runtime_error("Failed to open file: " + filename);
                 }
 
                 auto object = objectFactory(); // Use injected factory
+                MeshBuilder builder(*object);
                 vertexMap.clear();
 
+                // Progress is counted from line lengths plus the newline getline strips (absent only
+                // on an unterminated last line, where getline stops at end of file)
+                uint64_t bytesRead = 0;
                 std::string line;
-                if (!std::getline(file, line)) {
+                const auto readLine = [&]() -> bool {
+                    if (!std::getline(file, line)) return false;
+                    bytesRead += line.size() + (file.eof() ? 0 : 1);
+                    if (!line.empty() && line.back() == '\r') line.pop_back();
+                    return true;
+                };
+                size_t facesParsed = 0;
+                const auto reportProgress = [&]() {
+                    if (control) {
+                        control->report(bytesRead, object->getVertices().size(), facesParsed);
+                        control->throwIfCancelled();
+                    }
+                };
+                std::error_code sizeError;
+                const auto fileSize = std::filesystem::file_size(filename, sizeError);
+                if (control) {
+                    control->setTotalBytes(sizeError ? 0 : static_cast<uint64_t>(fileSize));
+                }
+
+                if (!readLine()) {
                     throw std::runtime_error("Empty file or failed to read header");
                 }
 
@@ -90,9 +130,24 @@ namespace Render {
                     }
                 }
 
+                // The counts come from the file, so they only size the reservations once the rest of the
+                // file could hold that many lines ("i,x,y,z" and "a,b,c" plus a newline at the least; the
+                // last line may lack its newline)
+                constexpr uint64_t MinVertexLineBytes = 8;
+                constexpr uint64_t MinFaceLineBytes = 6;
+                const uint64_t bytesLeft = sizeError ? 0 : static_cast<uint64_t>(fileSize) - std::min<uint64_t>(bytesRead, fileSize);
+                const uint64_t headerBytes = static_cast<uint64_t>(std::max(vertexCount, 0)) * MinVertexLineBytes +
+                    static_cast<uint64_t>(std::max(faceCount, 0)) * MinFaceLineBytes;
+                if (!sizeError && headerBytes > bytesLeft + 1) {
+                    throw std::runtime_error("Header counts exceed the file size");
+                }
+                if (vertexCount > 0 && faceCount > 0 && !sizeError) {
+                    builder.reserve(static_cast<size_t>(vertexCount), static_cast<size_t>(faceCount));
+                }
+
                 // Read vertices
                 for (int i = 0; i < vertexCount; ++i) {
-                    if (!std::getline(file, line)) {
+                    if (!readLine()) {
                         throw std::runtime_error("Unexpected end of file while reading vertices");
                     }
 
@@ -110,77 +165,118 @@ namespace Render {
                     if (vertexStream >> id >> comma >> x >> comma >> y >> comma >> z) {
                         vertexMap[id] = object->getVertices().size();
                         object->addVertex(Vertex(x, y, z));
+                        if (object->getVertices().size() % ProgressInterval == 0) reportProgress();
                     }
                     else {
                         throw std::runtime_error("Invalid vertex format at line " + std::to_string(i + 2));
                     }
                 }
 
+                // Read faces (the block bounds the trace scope)
+                {
+                    RENDER_TRACE_SCOPE("ObjectLoader::readFaces");
+                    for (int i = 0; i < faceCount; ++i) {
+                        if (!readLine()) {
+                            throw std::runtime_error("Unexpected end of file while reading faces");
+                        }
 
-                // Read Faces
-                for (int i = 0; i < faceCount; ++i) {
-                    if (!std::getline(file, line)) {
-                        throw std::runtime_error("Unexpected end of file while reading faces");
-                    }
-
-                    // Skip empty lines and comments
-                    if (line.empty() || line[0] == '#' || line[0] == '%') {
-                        --i; // Don't count this as a face
-                        continue;
-                    }
+                        // Skip empty lines and comments
+                        if (line.empty() || line[0] == '#' || line[0] == '%') {
+                            --i; // Don't count this as a face
+                            continue;
+                        }
 
-                    std::istringstream faceStream(line);
-                    int v1, v2, v3;
-                    char comma;
-                    bool validFormat = false;
+                        std::istringstream faceStream(line);
+                        int v1, v2, v3;
+                        char comma;
+                        bool validFormat = false;
 
-                    // Try comma-separated first
-                    if (faceStream >> v1 >> comma >> v2 >> comma >> v3 && comma == ',') {
-                        validFormat = true;
-                    }
-                    else {
-                        // Reset stream and try space-separated
-                        faceStream.clear();
-                        faceStream.seekg(0);
-                        if (faceStream >> v1 >> v2 >> v3) {
+                        // Try comma-separated first
+                        if (faceStream >> v1 >> comma >> v2 >> comma >> v3 && comma == ',') {
                             validFormat = true;
                         }
-                    }
+                        else {
+                            // Reset stream and try space-separated
+                            faceStream.clear();
+                            faceStream.seekg(0);
+                            if (faceStream >> v1 >> v2 >> v3) {
+                                validFormat = true;
+                            }
+                        }
 
-                    if (!validFormat) {
-                        throw std::runtime_error("Invalid face format at line " +
-                            std::to_string(vertexCount + i + 2));
-                    }
+                        if (!validFormat) {
+                            throw std::runtime_error("Invalid face format at line " +
+                                std::to_string(vertexCount + i + 2));
+                        }
                     
-                    if (vertexMap.find(v1) == vertexMap.end() ||
-                        vertexMap.find(v2) == vertexMap.end() ||
-                        vertexMap.find(v3) == vertexMap.end()) {
-                        throw std::runtime_error("Face references non-existent vertex ID at line " +
-                            std::to_string(vertexCount + i + 2));
-                    }
+                        if (vertexMap.find(v1) == vertexMap.end() ||
+                            vertexMap.find(v2) == vertexMap.end() ||
+                            vertexMap.find(v3) == vertexMap.end()) {
+                            throw std::runtime_error("Face references non-existent vertex ID at line " +
+                                std::to_string(vertexCount + i + 2));
+                        }
 
-                    // Get corresponding vertex indices
-                    size_t index1 = vertexMap[v1];
-                    size_t index2 = vertexMap[v2];
-                    size_t index3 = vertexMap[v3];
+                        // Get corresponding vertex indices
+                        size_t index1 = vertexMap[v1];
+                        size_t index2 = vertexMap[v2];
+                        size_t index3 = vertexMap[v3];
 
-                    // Validate indices are in range
-                    size_t vertexSize = object->getVertices().size();
-                    if (index1 >= vertexSize || index2 >= vertexSize || index3 >= vertexSize) {
-                        throw std::runtime_error("Invalid vertex index mapping at line " +
-                            std::to_string(vertexCount + i + 2));
-                    }
+                        // Validate indices are in range
+                        size_t vertexSize = object->getVertices().size();
+                        if (index1 >= vertexSize || index2 >= vertexSize || index3 >= vertexSize) {
+                            throw std::runtime_error("Invalid vertex index mapping at line " +
+                                std::to_string(vertexCount + i + 2));
+                        }
 
-                    // Add edges to create triangle
-                    object->addEdge(Edge(vertexMap[v1], vertexMap[v2]));
-                    object->addEdge(Edge(vertexMap[v2], vertexMap[v3]));
-                    object->addEdge(Edge(vertexMap[v3], vertexMap[v1]));
+                        // Triangle edges (deduplicated by finish) plus the face for hidden-line removal
+                        builder.addTriangle(index1, index2, index3);
+                        if (++facesParsed % ProgressInterval == 0) reportProgress();
+                    }
                 }
-                    
+
+                // finish() and normalizeObject() each walk the whole mesh, so cancellation is checked before both
+                reportProgress();
+                builder.finish();
+                if (control) control->throwIfCancelled();
                 normalizeObject(object);
                 return object;
             }
 
+            // Binary STL, binary PLY and OBJ; same normalization and edge deduplication as loadFromCSV
+            [[nodiscard]] std::unique_ptr<WireframeObject> loadFromSTL(const std::string& filename, LoadControl* control = nullptr) {
+                return loadWith([&](WireframeObject& object) { MeshReaders::readBinarySTL(filename, object, control); }, control);
+            }
+
+            [[nodiscard]] std::unique_ptr<WireframeObject> loadFromPLY(const std::string& filename, LoadControl* control = nullptr) {
+                return loadWith([&](WireframeObject& object) { MeshReaders::readBinaryPLY(filename, object, control); }, control);
+            }
+
+            [[nodiscard]] std::unique_ptr<WireframeObject> loadFromOBJ(const std::string& filename, LoadControl* control = nullptr) {
+                return loadWith([&](WireframeObject& object) { MeshReaders::readOBJ(filename, object, control); }, control);
+            }
+
+            // Picks the reader from the file extension (.stl, .ply, .obj; anything else is read as CSV)
+            [[nodiscard]] std::unique_ptr<WireframeObject> loadFromFile(const std::string& filename, LoadControl* control = nullptr) {
+                std::string extension = std::filesystem::path(filename).extension().string();
+                std::transform(extension.begin(), extension.end(), extension.begin(),
+                    [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+                if (extension == ".stl") return loadFromSTL(filename, control);
+                if (extension == ".ply") return loadFromPLY(filename, control);
+                if (extension == ".obj") return loadFromOBJ(filename, control);
+                return loadFromCSV(filename, control);
+            }
+
+            // Loads on a background thread with a copy of this loader's factory. Progress, cancellation
+            // and the finished object are reached through the returned handle.
+            [[nodiscard]] LoadHandle loadFromCSVAsync(const std::string& filename) const {
+                return startAsync(filename, static_cast<LoadMethod>(&ObjectLoader::loadFromCSV));
+            }
+
+            [[nodiscard]] LoadHandle loadFromFileAsync(const std::string& filename) const {
+                return startAsync(filename, &ObjectLoader::loadFromFile);
+            }
+
             void GenerateEdgesFromPointCloud(std::shared_ptr<WireframeObject> object) {
                 if (!object) return;
 
@@ -0,0 +1,46 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace Render {
+    // Number of chunks parallelChunks uses: one per 'minChunk' items, at most one per hardware thread
+    [[nodiscard]] inline size_t parallelChunkCount(size_t count, size_t minChunk) noexcept {
+        const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+        return std::clamp<size_t>(count / std::max<size_t>(minChunk, 1), 1, hardware);
+    }
+
+    // Splits [0, count) into parallelChunkCount contiguous chunks and calls fn(chunk, begin, end) for
+    // each. The first chunk runs on the calling thread; when no thread can be started a chunk runs
+    // there too. Returns after every chunk has finished. If a chunk throws, one exception is rethrown
+    // once every chunk that was started has finished.
+    template <typename Fn>
+    void parallelChunks(size_t count, size_t minChunk, Fn&& fn) {
+        const size_t chunks = parallelChunkCount(count, minChunk);
+        const size_t chunkSize = (count + chunks - 1) / chunks;
+        if (chunks == 1) {
+            fn(size_t{ 0 }, size_t{ 0 }, count);
+            return;
+        }
+
+        std::vector<std::future<void>> others;
+        others.reserve(chunks - 1);
+        for (size_t c = 1; c < chunks; ++c) {
+            const size_t begin = std::min(count, c * chunkSize);
+            const size_t end = std::min(count, begin + chunkSize);
+            try {
+                others.push_back(std::async(std::launch::async, [&fn, c, begin, end] { fn(c, begin, end); }));
+            }
+            catch (const std::system_error&) {
+                fn(c, begin, end);
+            }
+        }
+        fn(size_t{ 0 }, size_t{ 0 }, std::min(count, chunkSize));
+        for (auto& other : others) {
+            other.get();
+        }
+    }
+}
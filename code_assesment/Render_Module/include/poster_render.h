@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include "view_transform.h"
+#include "color.h"
+
+namespace Render {
+    class WireframeObject;
+
+    struct PosterOptions {
+        int width = 0;
+        int height = 0;
+        int bandHeight = 128; // Rows rendered at a time; each worker holds one band (width * bandHeight * 3 bytes)
+        unsigned maxWorkers = 0; // Band workers; 0 = one per hardware thread. 1 renders on the calling thread only
+        int vertexRadius = 3;
+        Color color = Color::Blue();
+        Color background = Color::Black();
+    };
+
+    struct PosterResult {
+        int bands = 0;
+        uint64_t binnedEdges = 0;    // (edge, band) pairs, i.e. edges drawn counting each band they cross
+        uint64_t binnedVertices = 0; // Likewise for vertex circles
+        size_t workingBytes = 0;     // Band buffers plus screen positions and bins
+        double seconds = 0.0;
+        std::string error;           // Empty on success
+    };
+
+    // Renders images too large to hold in memory (e.g. 50k x 50k posters). Vertices are projected once,
+    // edges and vertex circles are binned by the horizontal bands they touch, and the image is then
+    // rendered a few bands at a time (one per worker thread) and streamed to a binary PPM in row order.
+    // The band buffers depend only on the width and band height, but the bins grow with the image
+    // height too: one offset per band, plus one entry for every band each edge and circle touches,
+    // so tall images with long edges bin more (PosterResult::workingBytes reports the total). Pixels are
+    // identical to Renderer with LineMode::Aliased and no hidden-line removal; other modes are not supported.
+    class PosterRenderer {
+    private:
+        PosterOptions options;
+
+    public:
+        explicit PosterRenderer(const PosterOptions& options) noexcept : options(options) {}
+
+        // 'view' may be null for an object already in view space, as with Renderer::drawWireframeObject
+        [[nodiscard]] PosterResult render(const WireframeObject& object, const ViewTransform* view, std::ostream& out) const;
+        [[nodiscard]] PosterResult render(const WireframeObject& object, const ViewTransform* view, const std::string& filename) const;
+
+        [[nodiscard]] const PosterOptions& getOptions() const noexcept {
+            return options;
+        }
+    };
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "renderer.h"
+#include "framebuffer.h"
+#include "view_transform.h"
+#include "wireframe.h"
+
+namespace Render {
+    // A canned scene: a mesh, a camera and the renderer settings under test
+    struct RegressionScene {
+        std::string name; // Also the golden image's file name
+        std::function<std::unique_ptr<WireframeObject>()> makeMesh;
+        int width = 320;
+        int height = 240;
+        ViewTransform camera;
+        LineMode lineMode = LineMode::Aliased;
+        bool hiddenLines = false;
+        int vertexRadius = 1;
+        Color color = Color::White();
+        Color background = Color::Black();
+        int channelTolerance = 0;      // Per-channel difference allowed against the golden image
+        double pixelTolerance = 0.0;   // Fraction of pixels allowed beyond channelTolerance
+    };
+
+    struct ImageDifference {
+        bool sizeMismatch = false;
+        uint64_t pixelsOverTolerance = 0;
+        int maxChannelDifference = 0;
+    };
+
+    [[nodiscard]] ImageDifference compareImages(const FrameBuffer& actual, const FrameBuffer& expected, int channelTolerance) noexcept;
+
+    struct RegressionOptions {
+        std::string goldenDirectory;    // Holds <scene>.ppm; committed with the sources
+        std::string budgetFile;         // Timing budgets for this machine; empty = timings are reported, not checked
+        int timingRuns = 5;             // Samples; their median is compared against the budget
+        double minSampleSeconds = 0.02; // Each sample repeats the frame at least this long and reports the mean
+        double budgetTolerance = 1.25;  // Fail when the median exceeds budget * budgetTolerance
+        bool updateImages = false;      // Rewrite the golden images instead of comparing against them
+        bool updateBudgets = false;     // Record this machine's timings in budgetFile instead of checking them
+        bool collectStats = false;      // Attach RenderStats to each scene's renderer (adds a little to the timings)
+    };
+
+    struct RegressionResult {
+        std::string scene;
+        bool imagePassed = false;
+        bool timingPassed = false;
+        bool timingChecked = false;     // False without a budget for the scene; timingPassed is then true
+        ImageDifference difference;
+        double medianSeconds = 0.0;
+        double budgetSeconds = 0.0;     // 0 when the scene has no budget
+        std::string error;              // Missing golden image, unreadable files, ...
+        std::string statsReport;        // RenderStats::formatReport over the timed frames; empty unless collectStats
+
+        [[nodiscard]] bool passed() const noexcept {
+            return imagePassed && timingPassed && error.empty();
+        }
+    };
+
+    // Budgets are "<scene> <seconds>" lines; '#' starts a comment. Timings are machine-specific, so
+    // budget files are not committed: each machine that checks timings records its own once
+    // (RegressionOptions::updateBudgets) and passes it on later runs.
+    namespace RegressionBudgets {
+        [[nodiscard]] std::map<std::string, double> load(const std::string& filename);
+        bool save(const std::string& filename, const std::map<std::string, double>& budgets);
+    }
+
+    // Renders each scene through Renderer into a FrameBuffer, compares the frame with its golden
+    // image and times the render (mesh generation excluded) against the scene's budget. The default
+    // scenes' meshes use only arithmetic and sqrt, so their vertices are the same under every C runtime.
+    // The aliased scenes' cameras are built from constants and must match exactly (no tolerance); the
+    // anti-aliased and sub-pixel scenes use runtime sin/cos and allow a few pixels to differ.
+    class RegressionSuite {
+    private:
+        std::vector<RegressionScene> scenes;
+
+    public:
+        void addScene(RegressionScene scene) {
+            scenes.push_back(std::move(scene));
+        }
+
+        [[nodiscard]] const std::vector<RegressionScene>& getScenes() const noexcept {
+            return scenes;
+        }
+
+        // Generated meshes covering each line mode, hidden lines and perspective
+        [[nodiscard]] static RegressionSuite withDefaultScenes();
+
+        // One result per scene, in order. Whatever is being updated passes and is rewritten.
+        [[nodiscard]] std::vector<RegressionResult> run(const RegressionOptions& options) const;
+
+        // Tab-separated per-scene table followed by a PASS/FAIL line
+        static void writeReport(std::ostream& out, const std::vector<RegressionResult>& results);
+    };
+}
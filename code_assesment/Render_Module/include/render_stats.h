@@ -0,0 +1,261 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include "render_target_interface.h"
+
+namespace Render {
+    enum class RenderStage {
+        Load,
+        Transform,
+        Validation,
+        Projection,
+        Rasterization,
+        Clear,
+        Present,
+        Count
+    };
+
+    [[nodiscard]] inline const char* stageName(RenderStage stage) noexcept {
+        switch (stage) {
+        case RenderStage::Load: return "load";
+        case RenderStage::Transform: return "transform";
+        case RenderStage::Validation: return "validation";
+        case RenderStage::Projection: return "projection";
+        case RenderStage::Rasterization: return "rasterization";
+        case RenderStage::Clear: return "clear";
+        case RenderStage::Present: return "present";
+        default: return "unknown";
+        }
+    }
+
+    struct FrameCounters {
+        uint64_t edgesDrawn = 0;
+        uint64_t edgesCulled = 0;    // rejected before rasterization (e.g. hidden-line pyramid)
+        uint64_t edgesInvalid = 0;   // index out of range
+        uint64_t verticesDrawn = 0;  // vertex dots
+        uint64_t pixelsWritten = 0;
+        uint64_t pixelsClipped = 0;  // writes that fell outside the target
+        uint64_t heapAllocations = 0; // on the render thread; needs RENDER_COUNT_ALLOCATIONS
+    };
+
+    struct FrameStats {
+        std::array<double, static_cast<size_t>(RenderStage::Count)> stageSeconds{};
+        double totalSeconds = 0.0;
+        FrameCounters counters;
+    };
+
+    struct PercentileSummary {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+    };
+
+    // Per-frame counters and stage timings with a rolling window for percentiles.
+    // Not thread-safe; each renderer/thread should own its own instance.
+    class RenderStats {
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        std::vector<FrameStats> history; // ring buffer
+        size_t historyCapacity;
+        size_t historyNext = 0;
+        uint64_t framesRecorded = 0;
+
+        FrameStats current;
+        std::array<double, static_cast<size_t>(RenderStage::Count)> pendingSeconds{}; // recorded between frames
+        Clock::time_point frameStart;
+        bool inFrame = false;
+
+        template <typename Select>
+        [[nodiscard]] PercentileSummary summarize(Select select) const {
+            PercentileSummary summary;
+            if (history.empty()) return summary;
+
+            std::vector<double> values;
+            values.reserve(history.size());
+            for (const auto& frame : history) {
+                values.push_back(select(frame));
+            }
+            std::sort(values.begin(), values.end());
+
+            const auto at = [&values](double p) {
+                const size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+                return values[std::min(index, values.size() - 1)];
+            };
+            summary.p50 = at(0.50);
+            summary.p95 = at(0.95);
+            summary.p99 = at(0.99);
+            return summary;
+        }
+
+        void pushFrame(const FrameStats& frame) {
+            if (history.size() < historyCapacity) {
+                history.push_back(frame);
+            }
+            else {
+                history[historyNext] = frame;
+            }
+            historyNext = (historyNext + 1) % historyCapacity;
+        }
+
+    public:
+        explicit RenderStats(size_t windowSize = 240) : historyCapacity(std::max<size_t>(1, windowSize)) {
+            history.reserve(historyCapacity);
+        }
+
+        void beginFrame() noexcept {
+            current = FrameStats{};
+            current.stageSeconds = pendingSeconds;
+            pendingSeconds.fill(0.0);
+            frameStart = Clock::now();
+            inFrame = true;
+        }
+
+        void endFrame() {
+            if (!inFrame) return;
+            current.totalSeconds = std::chrono::duration<double>(Clock::now() - frameStart).count();
+            inFrame = false;
+            pushFrame(current);
+            framesRecorded++;
+        }
+
+        // Fold in frames recorded by another instance (e.g. one per worker thread, merged once they
+        // have finished): its window is added oldest first, as if this instance had recorded it
+        void merge(const RenderStats& other) {
+            const size_t count = other.history.size();
+            const size_t oldest = (count < other.historyCapacity) ? 0 : other.historyNext;
+            for (size_t i = 0; i < count; ++i) {
+                pushFrame(other.history[(oldest + i) % count]);
+            }
+            framesRecorded += other.framesRecorded;
+        }
+
+        // Time recorded outside a frame (e.g. a load) is carried into the next frame
+        void addStageTime(RenderStage stage, double seconds) noexcept {
+            auto& slots = inFrame ? current.stageSeconds : pendingSeconds;
+            slots[static_cast<size_t>(stage)] += seconds;
+        }
+
+        // Counters for the frame in progress
+        [[nodiscard]] FrameCounters& counters() noexcept { return current.counters; }
+
+        [[nodiscard]] const FrameStats& currentFrame() const noexcept { return current; }
+
+        // Most recently completed frame
+        [[nodiscard]] const FrameStats* lastFrame() const noexcept {
+            if (history.empty()) return nullptr;
+            return &history[(historyNext + historyCapacity - 1) % historyCapacity];
+        }
+
+        [[nodiscard]] uint64_t getFramesRecorded() const noexcept { return framesRecorded; }
+
+        // Frames kept for the percentiles
+        [[nodiscard]] size_t getWindowSize() const noexcept { return historyCapacity; }
+
+        [[nodiscard]] PercentileSummary stagePercentiles(RenderStage stage) const {
+            return summarize([stage](const FrameStats& f) { return f.stageSeconds[static_cast<size_t>(stage)]; });
+        }
+
+        [[nodiscard]] PercentileSummary framePercentiles() const {
+            return summarize([](const FrameStats& f) { return f.totalSeconds; });
+        }
+
+        void reset() noexcept {
+            history.clear();
+            historyNext = 0;
+            framesRecorded = 0;
+            current = FrameStats{};
+            pendingSeconds.fill(0.0);
+            inFrame = false;
+        }
+
+        // Human-readable table of the rolling percentiles (milliseconds) and last frame counters
+        [[nodiscard]] std::string formatReport() const {
+            std::string report;
+            char line[160];
+
+            std::snprintf(line, sizeof(line), "%-14s %10s %10s %10s\n", "stage (ms)", "p50", "p95", "p99");
+            report += line;
+
+            const auto addRow = [&](const char* name, const PercentileSummary& s) {
+                std::snprintf(line, sizeof(line), "%-14s %10.3f %10.3f %10.3f\n", name, s.p50 * 1e3, s.p95 * 1e3, s.p99 * 1e3);
+                report += line;
+            };
+            for (size_t i = 0; i < static_cast<size_t>(RenderStage::Count); ++i) {
+                addRow(stageName(static_cast<RenderStage>(i)), stagePercentiles(static_cast<RenderStage>(i)));
+            }
+            addRow("frame", framePercentiles());
+
+            if (const FrameStats* last = lastFrame()) {
+                const auto& c = last->counters;
+                std::snprintf(line, sizeof(line),
+                    "edges %llu (culled %llu, invalid %llu), dots %llu, pixels %llu (clipped %llu), allocations %llu\n",
+                    static_cast<unsigned long long>(c.edgesDrawn), static_cast<unsigned long long>(c.edgesCulled),
+                    static_cast<unsigned long long>(c.edgesInvalid), static_cast<unsigned long long>(c.verticesDrawn),
+                    static_cast<unsigned long long>(c.pixelsWritten), static_cast<unsigned long long>(c.pixelsClipped),
+                    static_cast<unsigned long long>(c.heapAllocations));
+                report += line;
+            }
+            return report;
+        }
+    };
+
+    // RAII timer adding its lifetime to a stage; a null stats pointer makes it a no-op
+    class ScopedStageTimer {
+    private:
+        RenderStats* stats;
+        RenderStage stage;
+        std::chrono::steady_clock::time_point start;
+
+    public:
+        ScopedStageTimer(RenderStats* stats, RenderStage stage) noexcept
+            : stats(stats), stage(stage), start(stats ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{}) {
+        }
+
+        ~ScopedStageTimer() {
+            if (stats) {
+                stats->addStageTime(stage, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            }
+        }
+
+        ScopedStageTimer(const ScopedStageTimer&) = delete;
+        ScopedStageTimer& operator=(const ScopedStageTimer&) = delete;
+    };
+
+    // Decorator that counts pixel writes on the way to the real target
+    class CountingRenderTarget final : public IRenderTarget {
+    private:
+        IRenderTarget& inner;
+        FrameCounters& counters;
+        int width, height;
+
+    public:
+        CountingRenderTarget(IRenderTarget& inner, FrameCounters& counters) noexcept
+            : inner(inner), counters(counters), width(inner.getWidth()), height(inner.getHeight()) {
+        }
+
+        void setPixel(int x, int y, const Color& color) noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                counters.pixelsWritten++;
+                inner.setPixel(x, y, color);
+            }
+            else {
+                counters.pixelsClipped++;
+            }
+        }
+
+        // Lets direct-write kernels bypass the wrapper and report their own pixel counts
+        [[nodiscard]] IRenderTarget& getInner() const noexcept { return inner; }
+        [[nodiscard]] FrameCounters& getCounters() const noexcept { return counters; }
+
+        [[nodiscard]] Color getPixel(int x, int y) const noexcept override { return inner.getPixel(x, y); }
+        [[nodiscard]] int getWidth() const noexcept override { return width; }
+        [[nodiscard]] int getHeight() const noexcept override { return height; }
+        void clear(const Color& color = Color::Black()) noexcept override { inner.clear(color); }
+    };
+}
@@ -12,4 +12,13 @@ namespace Render {
         virtual void clear(const Color& color = Color::Black()) noexcept = 0;
         virtual ~IRenderTarget() = default;
     };
+
+    // Implemented by targets whose storage is not row-major Color (tiled, bit-packed);
+    // output paths such as Renderer::saveFrame convert through it
+    class ILinearConvertible {
+    public:
+        // Write the frame row-major into 'out' (width * height pixels)
+        virtual void copyToLinear(Color* out) const noexcept = 0;
+        virtual ~ILinearConvertible() = default;
+    };
 }
\ No newline at end of file
@@ -1,28 +1,161 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
+#include <memory_resource>
+#include <span>
 #include "render_target_interface.h"
 #include "graphics_primitaves.h"
+#include "subpixel_line.h"
+#include "multi_line.h"
+#include "density_splat.h"
 #include "vector2D.h"
 #include "vector3D.h"
 #include "projection.h"
+#include "view_transform.h"
 #include "framebuffer.h"
+#include "tiled_framebuffer.h"
+#include "vertex.h"
+#include "edge.h"
+#include "depth_buffer.h"
+#include "render_stats.h"
+#include "trace.h"
+#include "frame_arena.h"
+#include "alloc_counter.h"
+#include "frame_writer.h"
+#include "video_stream_sink.h"
 
 namespace Render {
     // Forward declarations
     class WireframeObject;
 
+    // Line rasterization used for edges
+    enum class LineMode {
+        Aliased,     // Bresenham, one write per pixel
+        AntiAliased, // Wu-style coverage blended over the background
+        SubPixel     // 24.8 fixed-point DDA from unrounded endpoints (see drawLineSubPixel)
+    };
+
     // Main renderer class (Facade pattern)
     class Renderer {
     private:
         std::shared_ptr<IRenderTarget> renderTarget;
+        std::shared_ptr<AsyncFrameWriter> frameWriter; // Optional background output
+        LineMode lineMode = LineMode::Aliased;
+
+        // Hidden-line removal state (faces are rasterized into depthBuffer first)
+        bool hiddenLineRemoval = false;
+        float depthBias = 0.02f;
+        std::unique_ptr<DepthBuffer> depthBuffer;
+
+        // Point-cloud density buffers; created on first use
+        std::unique_ptr<DensitySplatter> densitySplatter;
+
+        // Optional instrumentation
+        std::shared_ptr<RenderStats> stats;
+
+        // Transient per-frame storage; reset by beginFrame (or per draw call outside a frame)
+        FrameArena frameArena{ 0 };
+        bool frameOpen = false;
+        uint64_t frameAllocationStart = 0;
+        mutable std::string filenameScratch;
+        mutable std::unique_ptr<FrameBuffer> linearScratch; // Row-major copy of an ILinearConvertible target for output
+
+        struct ScreenPoint {
+            int x, y;
+            float depth;
+            GraphicsPrimitives::Fixed24_8 subX, subY; // Unrounded position for LineMode::SubPixel
+            float screenX, screenY;                   // Unrounded position for the hidden-line occluders
+        };
+
+        // Edges are gathered into fixed-size blocks of endpoints before rasterizing
+        static constexpr size_t EdgeBlockSize = 256;
+
+        template <typename ToView, typename ToPlane>
+        static void projectPoints(std::span<const Vertex> vertices, ScreenPoint* out, float halfWidth, float halfHeight,
+            ToView&& toView, ToPlane&& toPlane) noexcept;
+        bool projectVertices(const IRenderTarget& target, std::span<const Vertex> vertices, const ViewTransform* view,
+            std::pmr::vector<ScreenPoint>& screenPoints) noexcept;
+        template <typename Index>
+        void rasterizeEdges(IRenderTarget& target, std::span<const ScreenPoint> screenPoints, std::span<const BasicEdge<Index>> edges,
+            const Color& color, bool indicesValidated, FrameCounters& counters) noexcept;
+        void recordCounters(const FrameCounters& counters) noexcept;
+        void drawWireframeObjectTo(IRenderTarget& target, const WireframeObject& object, const ViewTransform* view,
+            int vertexRadius, const Color& color) noexcept;
+        void drawPointDensityTo(const WireframeObject& object, const ViewTransform* view, const DensitySplatOptions& options) noexcept;
+        bool drawHiddenLineObject(IRenderTarget& target, const WireframeObject& object,
+            std::span<const ScreenPoint> screenPoints, int vertexRadius, const Color& color, FrameCounters& counters) noexcept;
 
     public:
         explicit Renderer(std::shared_ptr<IRenderTarget> target) noexcept
             : renderTarget(std::move(target)) {
         }
 
+        // Route saveFrame through a background writer (nullptr restores synchronous PPM output)
+        void setFrameWriter(std::shared_ptr<AsyncFrameWriter> writer) noexcept {
+            frameWriter = std::move(writer);
+        }
+
+        [[nodiscard]] const std::shared_ptr<AsyncFrameWriter>& getFrameWriter() const noexcept {
+            return frameWriter;
+        }
+
+        void setLineMode(LineMode mode) noexcept {
+            lineMode = mode;
+        }
+
+        [[nodiscard]] LineMode getLineMode() const noexcept {
+            return lineMode;
+        }
+
+        // Depth-test edges against the object's faces; objects without faces draw as before. Every
+        // LineMode has a depth-tested rasterizer, so the line mode is kept.
+        // 'bias' is in view-space depth units and lets edges lying on a face pass the test.
+        void setHiddenLineRemoval(bool enabled, float bias = 0.02f) noexcept {
+            hiddenLineRemoval = enabled;
+            depthBias = bias;
+        }
+
+        [[nodiscard]] bool getHiddenLineRemoval() const noexcept {
+            return hiddenLineRemoval;
+        }
+
+        // Attach a stats collector; counters and stage timings are recorded between beginFrame/endFrame
+        void setStats(std::shared_ptr<RenderStats> collector) noexcept {
+            stats = std::move(collector);
+        }
+
+        [[nodiscard]] const std::shared_ptr<RenderStats>& getStats() const noexcept {
+            return stats;
+        }
+
+        // Frame boundaries: recycle the frame arena and, when stats are attached, record the frame
+        void beginFrame() noexcept {
+            try {
+                frameArena.reset();
+            }
+            catch (const std::exception&) {
+                // Coalescing failed; the arena is rewound and keeps its existing blocks
+            }
+            frameOpen = true;
+            frameAllocationStart = AllocationCounter::threadCount();
+            if (stats) stats->beginFrame();
+        }
+
+        void endFrame() {
+            frameOpen = false;
+            if (stats) {
+                stats->counters().heapAllocations = AllocationCounter::threadCount() - frameAllocationStart;
+                stats->endFrame();
+            }
+        }
+
+        [[nodiscard]] const FrameArena& getFrameArena() const noexcept {
+            return frameArena;
+        }
+
         void clear(const Color& color = Color::Black()) noexcept {
+            ScopedStageTimer timer(stats.get(), RenderStage::Clear);
             renderTarget->clear(color);
         }
 
@@ -50,17 +183,78 @@ namespace Render {
                 end2D, renderTarget->getWidth(), renderTarget->getHeight());
 
             // Draw line
-            GraphicsPrimitives::drawLine(*renderTarget, start_x, start_y, end_x, end_y, color);
+            if (lineMode == LineMode::SubPixel) {
+                GraphicsPrimitives::drawLineSubPixel(*renderTarget,
+                    GraphicsPrimitives::worldToScreenF(start2D, renderTarget->getWidth(), renderTarget->getHeight()),
+                    GraphicsPrimitives::worldToScreenF(end2D, renderTarget->getWidth(), renderTarget->getHeight()), color);
+            }
+            else if (lineMode == LineMode::AntiAliased) {
+                GraphicsPrimitives::drawLineAA(*renderTarget, start_x, start_y, end_x, end_y, color);
+            }
+            else {
+                GraphicsPrimitives::drawLine(*renderTarget, start_x, start_y, end_x, end_y, color);
+            }
         }
 
+        // Draw a contiguous edge list against contiguous vertices. Pass indicesValidated when every
+        // edge index is known to be in range (see WireframeObject::hasValidEdgeIndices) to skip per-edge checks.
+        // Instantiated for Edge16, Edge32 and EdgeWide (which covers Edge).
+        template <typename Index>
+        void drawEdgeBatch(std::span<const Vertex> vertices, std::span<const BasicEdge<Index>> edges, const Color& color,
+            bool indicesValidated = false) noexcept;
+
         // Render a wireframe object
         void drawWireframeObject(const WireframeObject& object, int vertexRadius, const Color& color = Color::Blue()) noexcept;
 
-        // Save the current frame
+        // Render a world-space object through a camera; the view matrix is applied during projection
+        void drawWireframeObject(const WireframeObject& object, const ViewTransform& view, int vertexRadius,
+            const Color& color = Color::Blue()) noexcept;
+
+        // Point-cloud mode: the vertices become a density image (one count per point, tone-mapped)
+        // that replaces the frame's contents; edges are not drawn
+        void drawPointDensity(const WireframeObject& object, const DensitySplatOptions& options = {}) noexcept;
+        void drawPointDensity(const WireframeObject& object, const ViewTransform& view, const DensitySplatOptions& options = {}) noexcept;
+
+        // Save the current frame; with a frame writer attached this only queues it.
+        // Stream sinks append the frame to their stream and ignore the filename.
+        // Targets with other layouts (ILinearConvertible) are converted to row-major here, once per saved frame.
         bool saveFrame(const std::string& filenamePrefix, int frameCount) const noexcept {
-            if (auto* frameBuffer = dynamic_cast<FrameBuffer*>(renderTarget.get())) {
-                const std::string filename = filenamePrefix + "_" + std::to_string(frameCount) + ".ppm";
-                return frameBuffer->saveToPPM(filename);
+            ScopedStageTimer timer(stats.get(), RenderStage::Present);
+            RENDER_TRACE_SCOPE("Renderer::saveFrame");
+            if (auto* streamSink = dynamic_cast<VideoStreamSink*>(renderTarget.get())) {
+                return streamSink->writeFrame();
+            }
+            const FrameBuffer* frameBuffer = dynamic_cast<FrameBuffer*>(renderTarget.get());
+            if (auto* convertible = dynamic_cast<const ILinearConvertible*>(renderTarget.get())) {
+                try {
+                    if (!linearScratch || linearScratch->getWidth() != renderTarget->getWidth() ||
+                        linearScratch->getHeight() != renderTarget->getHeight()) {
+                        linearScratch = std::make_unique<FrameBuffer>(renderTarget->getWidth(), renderTarget->getHeight());
+                    }
+                    convertible->copyToLinear(linearScratch->getPixelData());
+                    frameBuffer = linearScratch.get();
+                }
+                catch (const std::exception&) {
+                    return false;
+                }
+            }
+            if (frameBuffer) {
+                try {
+                    // Built in a reused string so steady-state saves don't allocate on this thread
+                    char number[16];
+                    std::snprintf(number, sizeof(number), "_%d.", frameCount);
+                    filenameScratch.assign(filenamePrefix).append(number);
+
+                    if (frameWriter) {
+                        filenameScratch.append(frameWriter->getEncoder().extension());
+                        return frameWriter->submit(*frameBuffer, filenameScratch);
+                    }
+                    filenameScratch.append("ppm");
+                    return frameBuffer->saveToPPM(filenameScratch);
+                }
+                catch (const std::exception&) {
+                    return false;
+                }
             }
             return false;
         }
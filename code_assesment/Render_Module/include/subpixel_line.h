@@ -0,0 +1,153 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <utility>
+#include "Vector2D.h"
+#include "render_target_interface.h"
+#include "depth_buffer.h"
+
+namespace Render {
+    namespace GraphicsPrimitives {
+        // 24.8 fixed-point screen coordinate (1/256 pixel)
+        using Fixed24_8 = int32_t;
+        inline constexpr int SubPixelBits = 8;
+        inline constexpr Fixed24_8 SubPixelOne = 1 << SubPixelBits;
+        inline constexpr Fixed24_8 SubPixelHalf = SubPixelOne / 2;
+
+        // Quantize a continuous screen coordinate, rounding to nearest. The range is clamped
+        // to +-2^29 (about two million pixels) so endpoint differences never overflow.
+        [[nodiscard]] inline Fixed24_8 toFixed(float value) noexcept {
+            constexpr float limit = static_cast<float>(1 << (29 - SubPixelBits));
+            if (!(value == value)) return 0; // NaN
+            return static_cast<Fixed24_8>(std::lround(std::clamp(value, -limit, limit) * static_cast<float>(SubPixelOne)));
+        }
+
+        namespace Detail {
+            // A line reduced to its major-axis walk: pixel centres [first, last) clipped to the target,
+            // and the minor-axis position at 'first' with 16 extra fractional bits plus its per-pixel step
+            struct FixedSpan {
+                int first, last;
+                int64_t minor, step;
+                bool steep;
+            };
+
+            inline constexpr int SpanMinorShift = SubPixelBits + 16;
+
+            // Orders the endpoints along the major axis and clips it; false when no pixel centre is covered
+            [[nodiscard]] inline bool setupFixedSpan(Fixed24_8 x0, Fixed24_8 y0, Fixed24_8 x1, Fixed24_8 y1,
+                int width, int height, FixedSpan& span) noexcept {
+                // Selects rather than swaps: line direction is random per edge and mispredicts badly
+                span.steep = std::abs(x1 - x0) < std::abs(y1 - y0);
+                const Fixed24_8 major0 = span.steep ? y0 : x0;
+                const Fixed24_8 minor0 = span.steep ? x0 : y0;
+                const Fixed24_8 major1 = span.steep ? y1 : x1;
+                const Fixed24_8 minor1 = span.steep ? x1 : y1;
+                const bool reversed = major0 > major1;
+                x0 = reversed ? major1 : major0;
+                y0 = reversed ? minor1 : minor0;
+                x1 = reversed ? major0 : major1;
+                y1 = reversed ? minor0 : minor1;
+
+                const int64_t majorDelta = static_cast<int64_t>(x1) - x0;
+                if (majorDelta == 0) return false;
+
+                // Minor-axis change per major-axis sub-pixel, with 16 extra fractional bits, truncated toward
+                // zero. Both operands are exact in double and the quotient is at most 2^16, so its rounding
+                // error (under 2^-37) is smaller than the gap to the next integer (at least 1/majorDelta >
+                // 2^-31): truncating the double gives the integer division's result on every platform,
+                // without a 64-bit integer divide per line.
+                const int64_t slope = static_cast<int64_t>(
+                    static_cast<double>(static_cast<int64_t>(y1 - y0) * 65536) / static_cast<double>(majorDelta));
+
+                // Pixels whose centre lies in [x0, x1), clipped to the target
+                span.first = std::max((x0 - SubPixelHalf + SubPixelOne - 1) >> SubPixelBits, 0);
+                span.last = std::min((x1 - SubPixelHalf + SubPixelOne - 1) >> SubPixelBits, span.steep ? height : width);
+                if (span.first >= span.last) return false;
+
+                const int64_t firstCentre = static_cast<int64_t>(span.first) * SubPixelOne + SubPixelHalf;
+                span.minor = static_cast<int64_t>(y0) * 65536 + (firstCentre - x0) * slope;
+                span.step = slope * SubPixelOne;
+                return true;
+            }
+
+            // No data-dependent branches: one shift, one plot and one add per pixel
+            template <bool Steep, typename Plot>
+            inline void walkFixedSpan(const FixedSpan& span, Plot&& plot) noexcept {
+                int64_t minor = span.minor;
+                for (int i = span.first; i < span.last; ++i) {
+                    const int m = static_cast<int>(minor >> SpanMinorShift);
+                    if constexpr (Steep) {
+                        plot(m, i);
+                    }
+                    else {
+                        plot(i, m);
+                    }
+                    minor += span.step;
+                }
+            }
+        }
+
+        // Fixed-point DDA line with sub-pixel endpoints.
+        //
+        // Coverage rule: pixel (i, j) spans [i, i+1) x [j, j+1) with its centre at (i + 0.5, j + 0.5).
+        // The major axis is x when |dx| >= |dy|, otherwise y. For every major-axis pixel centre c with
+        // min(start, end) <= c < max(start, end) exactly one pixel is lit: the one whose minor-axis span
+        // contains the DDA's estimate of the line at c (a position exactly on a pixel boundary goes to the
+        // higher row/column). The estimate steps by the slope truncated to 2^-16 sub-pixels, so it trails
+        // the true line by less than length / 65536 pixels: lines shorter than 65536 pixels stay within
+        // one pixel, and only a line passing that close to a pixel boundary can light the neighbour.
+        // The interval is half-open, so edges sharing a vertex never both light the vertex pixel
+        // along the same axis and a zero-length line lights nothing. The result does not depend on
+        // endpoint order, and the arithmetic after toFixed is integer apart from the slope division
+        // (see setupFixedSpan), so it is identical on every platform.
+        inline void drawLineSubPixel(IRenderTarget& target, Fixed24_8 x0, Fixed24_8 y0, Fixed24_8 x1, Fixed24_8 y1,
+            const Color& color) noexcept {
+            Detail::FixedSpan span;
+            if (!Detail::setupFixedSpan(x0, y0, x1, y1, target.getWidth(), target.getHeight(), span)) return;
+
+            const auto plot = [&target, &color](int x, int y) noexcept { target.setPixel(x, y, color); };
+            if (span.steep) {
+                Detail::walkFixedSpan<true>(span, plot);
+            }
+            else {
+                Detail::walkFixedSpan<false>(span, plot);
+            }
+        }
+
+        // Continuous screen-space endpoints (see worldToScreenF)
+        inline void drawLineSubPixel(IRenderTarget& target, const Math::Vector2D& start, const Math::Vector2D& end,
+            const Color& color) noexcept {
+            drawLineSubPixel(target, toFixed(start.x), toFixed(start.y), toFixed(end.x), toFixed(end.y), color);
+        }
+
+        // drawLineSubPixel lighting only the pixels that pass the depth test; depth is interpolated
+        // linearly along the major axis and sampled at each pixel centre
+        inline void drawLineSubPixelDepthTested(IRenderTarget& target, const DepthBuffer& depthBuffer,
+            Fixed24_8 x0, Fixed24_8 y0, float z0, Fixed24_8 x1, Fixed24_8 y1, float z1, const Color& color, float bias) noexcept {
+            Detail::FixedSpan span;
+            if (!Detail::setupFixedSpan(x0, y0, x1, y1, target.getWidth(), target.getHeight(), span)) return;
+
+            // The span walks from the endpoint with the smaller major coordinate
+            const Fixed24_8 major0 = span.steep ? y0 : x0;
+            const Fixed24_8 major1 = span.steep ? y1 : x1;
+            const bool reversed = major0 > major1;
+            const float zStart = reversed ? z1 : z0;
+            const float zPerSubPixel = ((reversed ? z0 : z1) - zStart) / static_cast<float>(std::abs(major1 - major0));
+            const Fixed24_8 majorStart = reversed ? major1 : major0;
+
+            float z = zStart + static_cast<float>(span.first * SubPixelOne + SubPixelHalf - majorStart) * zPerSubPixel;
+            const float zStep = zPerSubPixel * static_cast<float>(SubPixelOne);
+            const auto plot = [&](int x, int y) noexcept {
+                if (depthBuffer.isVisible(x, y, z, bias)) target.setPixel(x, y, color);
+                z += zStep;
+            };
+            if (span.steep) {
+                Detail::walkFixedSpan<true>(span, plot);
+            }
+            else {
+                Detail::walkFixedSpan<false>(span, plot);
+            }
+        }
+    }
+}
\ No newline at end of file
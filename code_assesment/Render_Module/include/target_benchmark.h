@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include "render_target_interface.h"
+
+namespace Render {
+    struct TargetBenchmarkOptions {
+        int lineCount = 20000;   // Per line kind
+        int circleCount = 20000;
+        int minRadius = 2;
+        int maxRadius = 16;
+        uint32_t seed = 1;       // Same seed = same primitives, so targets of equal size draw identical work
+    };
+
+    struct TargetBenchmarkResult {
+        double steepLineSeconds = 0.0;   // |dy| > |dx|: one row per pixel
+        double shallowLineSeconds = 0.0; // |dx| >= |dy|: mostly along a row
+        double circleSeconds = 0.0;      // Filled circles (drawCircle)
+        uint64_t steepLinePixels = 0;
+        uint64_t shallowLinePixels = 0;
+        uint64_t circlePixels = 0;
+
+        [[nodiscard]] static double rate(uint64_t pixels, double seconds) noexcept {
+            return seconds > 0.0 ? static_cast<double>(pixels) / seconds : 0.0;
+        }
+        [[nodiscard]] double steepLinePixelsPerSecond() const noexcept { return rate(steepLinePixels, steepLineSeconds); }
+        [[nodiscard]] double shallowLinePixelsPerSecond() const noexcept { return rate(shallowLinePixels, shallowLineSeconds); }
+        [[nodiscard]] double circlePixelsPerSecond() const noexcept { return rate(circlePixels, circleSeconds); }
+    };
+
+    // Times GraphicsPrimitives::drawLine and drawCircle on 'target' with pseudo-random primitives
+    // spread over the whole target. Comparing a FrameBuffer with a TiledFrameBuffer of the same size
+    // shows what the storage layout costs or saves; use a target larger than the last-level cache.
+    // Render_Tests --benchmark runs it on every target layout.
+    [[nodiscard]] TargetBenchmarkResult benchmarkTarget(IRenderTarget& target, const TargetBenchmarkOptions& options = {}) noexcept;
+
+    // Tab-separated: name, then megapixels per second for steep lines, shallow lines and circles
+    void writeTargetBenchmark(std::ostream& out, const std::string& name, const TargetBenchmarkResult& result);
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include "framebuffer.h"
+
+namespace Render {
+    // Frame stored as 8x8 tiles, each tile's 64 pixels contiguous (192 bytes, three cache lines) and
+    // tiles row-major across the frame. A steep line or a small filled circle then stays within a few
+    // cache lines per 8 rows instead of touching a new line (and often a new page) on every row as it
+    // does in the row-major FrameBuffer. Conversion to row-major happens only when the frame is saved
+    // or copied out for presentation.
+    class TiledFrameBuffer final : public LinearConvertibleTarget {
+    public:
+        static constexpr int TileShift = 3;
+        static constexpr int TileSize = 1 << TileShift;
+        static constexpr int TilePixels = TileSize * TileSize;
+
+    private:
+        int width, height;
+        int tilesX, tilesY;
+        std::vector<Color> tiles; // Padded to whole tiles
+
+        [[nodiscard]] size_t indexOf(int x, int y) const noexcept {
+            const size_t tile = static_cast<size_t>(y >> TileShift) * tilesX + static_cast<size_t>(x >> TileShift);
+            return tile * TilePixels + static_cast<size_t>(((y & (TileSize - 1)) << TileShift) | (x & (TileSize - 1)));
+        }
+
+    public:
+        explicit TiledFrameBuffer(int width, int height)
+            : width(width), height(height),
+            tilesX((std::max(width, 0) + TileSize - 1) >> TileShift),
+            tilesY((std::max(height, 0) + TileSize - 1) >> TileShift) {
+            tiles.resize(static_cast<size_t>(tilesX) * static_cast<size_t>(tilesY) * TilePixels, Color::Black());
+        }
+
+        void setPixel(int x, int y, const Color& color) noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                tiles[indexOf(x, y)] = color;
+            }
+        }
+
+        [[nodiscard]] Color getPixel(int x, int y) const noexcept override {
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                return tiles[indexOf(x, y)];
+            }
+            return Color::Black();
+        }
+
+        [[nodiscard]] int getWidth() const noexcept override { return width; }
+        [[nodiscard]] int getHeight() const noexcept override { return height; }
+
+        // Padding pixels are cleared too; they are never read back
+        void clear(const Color& color = Color::Black()) noexcept override {
+            std::fill(tiles.begin(), tiles.end(), color);
+        }
+
+        [[nodiscard]] int getTilesX() const noexcept { return tilesX; }
+        [[nodiscard]] int getTilesY() const noexcept { return tilesY; }
+
+        // Tile storage for kernels that compute addresses themselves (see the class comment for the layout)
+        [[nodiscard]] Color* getTileData() noexcept {
+            return tiles.data();
+        }
+
+        // Converts one tile row at a time
+        void copyToLinear(Color* out) const noexcept override {
+            for (int tileY = 0; tileY < tilesY; ++tileY) {
+                const int rows = std::min(TileSize, height - tileY * TileSize);
+                const Color* tileRow = tiles.data() + static_cast<size_t>(tileY) * tilesX * TilePixels;
+                for (int row = 0; row < rows; ++row) {
+                    Color* dst = out + static_cast<size_t>(tileY * TileSize + row) * width;
+                    for (int tileX = 0; tileX < tilesX; ++tileX) {
+                        const int columns = std::min(TileSize, width - tileX * TileSize);
+                        const Color* src = tileRow + static_cast<size_t>(tileX) * TilePixels + row * TileSize;
+                        std::memcpy(dst + tileX * TileSize, src, sizeof(Color) * columns);
+                    }
+                }
+            }
+        }
+    };
+}
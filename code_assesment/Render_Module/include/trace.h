@@ -0,0 +1,53 @@
+#pragma once
+// Scoped timeline tracing exported as Chrome trace-event JSON (chrome://tracing, Perfetto).
+// Compiled out unless RENDER_ENABLE_TRACING is defined (add it to the preprocessor definitions of the
+// projects to profile); the macros then expand to nothing and the viewer has no T (trace) key.
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace Render {
+    namespace Trace {
+        // Begin collecting events; each thread keeps its last 'eventsPerThread' events
+        void start(size_t eventsPerThread = 65536);
+        void stop() noexcept;
+        [[nodiscard]] bool isEnabled() noexcept;
+
+        // Name the calling thread in the exported timeline
+        void setThreadName(const char* name);
+
+        // Write everything collected in the current session; call after stop() so no thread is still recording
+        bool writeJson(const std::string& filename);
+
+        void recordEvent(const char* name, uint64_t startNs, uint64_t endNs) noexcept;
+        [[nodiscard]] uint64_t nowNs() noexcept;
+
+        // RAII complete event ("ph":"X"); 'name' must be a string literal or otherwise outlive the session
+        class ScopedEvent {
+        private:
+            const char* name;
+            uint64_t start;
+
+        public:
+            explicit ScopedEvent(const char* name) noexcept : name(name), start(isEnabled() ? nowNs() : 0) {}
+            ~ScopedEvent() {
+                if (start != 0) {
+                    recordEvent(name, start, nowNs());
+                }
+            }
+
+            ScopedEvent(const ScopedEvent&) = delete;
+            ScopedEvent& operator=(const ScopedEvent&) = delete;
+        };
+    }
+}
+
+#ifdef RENDER_ENABLE_TRACING
+#define RENDER_TRACE_CONCAT_INNER(a, b) a##b
+#define RENDER_TRACE_CONCAT(a, b) RENDER_TRACE_CONCAT_INNER(a, b)
+#define RENDER_TRACE_SCOPE(name) ::Render::Trace::ScopedEvent RENDER_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define RENDER_TRACE_THREAD_NAME(name) ::Render::Trace::setThreadName(name)
+#else
+#define RENDER_TRACE_SCOPE(name) ((void)0)
+#define RENDER_TRACE_THREAD_NAME(name) ((void)0)
+#endif
@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "wireframe.h"
+#include "matrix4x4.h"
+#include "trace.h"
+
+namespace Render {
+    // World-space copy of a WireframeObject that follows edits to the source through its change log.
+    // Appends and position updates re-transform only the affected ranges; removals, new faces, a
+    // different source object or a truncated history fall back to one full copy and transform.
+    class TransformedObjectCache {
+    private:
+        WireframeObject cached;
+        Math::Matrix4x4 matrix;
+        uint64_t meshId = 0;
+        uint64_t revision = 0;
+        bool valid = false;
+
+        // Reused between updates so steady-state edits don't allocate
+        std::vector<Vertex> vertexScratch;
+        std::vector<Math::Vector3D> positionScratch;
+        std::vector<Edge> edgeScratch;
+
+        void rebuild(const WireframeObject& source) {
+            RENDER_TRACE_SCOPE("TransformedObjectCache::rebuild");
+            cached = source;
+            cached.transform(matrix);
+        }
+
+        void appendVertices(const WireframeObject& source, std::size_t begin, std::size_t end) {
+            // Merged appends may start with vertices this cache already holds
+            begin = std::max(begin, cached.getVertices().size());
+            if (begin >= end) return;
+            const Math::PointTransformer transformer(matrix);
+            vertexScratch.assign(source.getVertices().begin() + static_cast<std::ptrdiff_t>(begin),
+                source.getVertices().begin() + static_cast<std::ptrdiff_t>(end));
+            for (auto& vertex : vertexScratch) {
+                vertex.setPosition(transformer(vertex.getPosition()));
+            }
+            cached.appendVertices(vertexScratch);
+        }
+
+        void updateVertices(const WireframeObject& source, std::size_t begin, std::size_t end) {
+            const Math::PointTransformer transformer(matrix);
+            const auto& vertices = source.getVertices();
+            positionScratch.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                positionScratch.push_back(transformer(vertices[i].getPosition()));
+            }
+            cached.updateVertices(begin, positionScratch);
+        }
+
+        void appendEdges(const WireframeObject& source, std::size_t begin, std::size_t end) {
+            begin = std::max(begin, cached.getEdgeCount());
+            if (begin >= end) return;
+            edgeScratch.clear();
+            for (std::size_t i = begin; i < end; ++i) {
+                edgeScratch.push_back(source.getEdge(i));
+            }
+            cached.appendEdges(edgeScratch);
+        }
+
+        // False when the change can't be applied in place
+        bool apply(const WireframeObject& source, const MeshChange& change) {
+            // A range may describe an older, larger mesh that later changes shrank again
+            const std::size_t vertexCount = source.getVertices().size();
+            switch (change.kind) {
+            case MeshChangeKind::VerticesAppended:
+                appendVertices(source, change.begin, std::min(change.end, vertexCount));
+                return true;
+            case MeshChangeKind::VerticesUpdated:
+                updateVertices(source, std::min(change.begin, vertexCount), std::min(change.end, vertexCount));
+                return true;
+            case MeshChangeKind::EdgesAppended:
+                appendEdges(source, change.begin, std::min(change.end, source.getEdgeCount()));
+                return true;
+            default:
+                return false;
+            }
+        }
+
+    public:
+        // Bring the cache up to date with 'source' drawn through 'transform'
+        void update(const WireframeObject& source, const Math::Matrix4x4& transform) {
+            RENDER_TRACE_SCOPE("TransformedObjectCache::update");
+            const MeshChangeLog& log = source.getChangeLog();
+            const bool matrixChanged = !(transform == matrix);
+            matrix = transform;
+
+            bool incremental = valid && log.getMeshId() == meshId;
+            if (incremental) {
+                bool applied = true;
+                const bool reachable = log.forEachSince(revision, [&](const MeshChange& change) {
+                    if (applied) applied = apply(source, change);
+                });
+                incremental = reachable && applied;
+            }
+            incremental = incremental && cached.getVertices().size() == source.getVertices().size() &&
+                cached.getEdgeCount() == source.getEdgeCount();
+
+            if (!incremental) {
+                rebuild(source);
+            }
+            else if (matrixChanged) {
+                updateVertices(source, 0, source.getVertices().size());
+            }
+
+            meshId = log.getMeshId();
+            revision = log.getRevision();
+            valid = true;
+        }
+
+        // Force a full rebuild on the next update
+        void invalidate() noexcept {
+            valid = false;
+        }
+
+        [[nodiscard]] const WireframeObject& get() const noexcept {
+            return cached;
+        }
+    };
+}
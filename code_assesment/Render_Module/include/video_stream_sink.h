@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include "render_target_interface.h"
+#include "framebuffer.h"
+
+namespace Render {
+    enum class StreamFormat {
+        RawRGB, // rgb24 frames back to back, no header
+        Y4M     // YUV4MPEG2 with 4:2:0 (JPEG/full range) chroma
+    };
+
+    namespace VideoConvert {
+        // Full-range BT.601 RGB to planar YUV 4:2:0; chroma is the 2x2 block average
+        // Plane sizes: y = width*height, u = v = ((width+1)/2) * ((height+1)/2)
+        void rgbToYUV420(const Color* pixels, int width, int height,
+            uint8_t* yPlane, uint8_t* uPlane, uint8_t* vPlane) noexcept;
+    }
+
+    // Render target that streams each finished frame to a file/pipe instead of one file per frame
+    class VideoStreamSink final : public IRenderTarget {
+    private:
+        FrameBuffer frame;
+        std::FILE* out;
+        bool ownsStream;
+        StreamFormat format;
+        int framesPerSecond;
+        bool headerWritten = false;
+        uint64_t framesWritten = 0;
+        std::vector<uint8_t> yuvScratch; // reused between frames
+
+        bool writeHeader() noexcept;
+
+    public:
+        // Does not take ownership of 'stream'
+        explicit VideoStreamSink(int width, int height, std::FILE* stream,
+            StreamFormat format = StreamFormat::Y4M, int fps = 30);
+        ~VideoStreamSink() override;
+
+        VideoStreamSink(const VideoStreamSink&) = delete;
+        VideoStreamSink& operator=(const VideoStreamSink&) = delete;
+
+        // Stream to standard output (switched to binary mode where required)
+        [[nodiscard]] static std::unique_ptr<VideoStreamSink> toStdout(int width, int height,
+            StreamFormat format = StreamFormat::Y4M, int fps = 30);
+
+        // Stream to an already open descriptor such as a pipe; the sink closes it on destruction
+        [[nodiscard]] static std::unique_ptr<VideoStreamSink> toDescriptor(int fd, int width, int height,
+            StreamFormat format = StreamFormat::Y4M, int fps = 30);
+
+        // IRenderTarget implementation
+        void setPixel(int x, int y, const Color& color) noexcept override { frame.setPixel(x, y, color); }
+        [[nodiscard]] Color getPixel(int x, int y) const noexcept override { return frame.getPixel(x, y); }
+        [[nodiscard]] int getWidth() const noexcept override { return frame.getWidth(); }
+        [[nodiscard]] int getHeight() const noexcept override { return frame.getHeight(); }
+        void clear(const Color& color = Color::Black()) noexcept override { frame.clear(color); }
+
+        // Append the current contents as the next frame of the stream
+        bool writeFrame() noexcept;
+
+        // Append a frame rendered elsewhere; it must match the stream's dimensions
+        bool writeFrame(const FrameBuffer& source) noexcept;
+
+        [[nodiscard]] uint64_t getFramesWritten() const noexcept { return framesWritten; }
+        [[nodiscard]] const FrameBuffer& getFrameBuffer() const noexcept { return frame; }
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <algorithm>
+#include "Vector2D.h"
+#include "Vector3D.h"
+#include "matrix4x4.h"
+#include "projection.h"
+
+namespace Render {
+    // How view-space positions map to the screen
+    enum class Projection {
+        Orthographic, // x and y map straight to normalized device coordinates
+        Perspective   // x and y are divided by depth (-z) and scaled by the focal length
+    };
+
+    // World-to-view matrix applied while projecting, so one world-space object can be drawn
+    // from several cameras without copying it. Perspective does not clip at the near plane;
+    // keep the object in front of the camera.
+    struct ViewTransform {
+        Math::Matrix4x4 view;
+        Projection projection = Projection::Orthographic;
+        float focalLength = 1.0f;
+    };
+
+    namespace Detail {
+        // Depth floor for the perspective divide; points behind the camera are pinned to it
+        inline constexpr float PerspectiveNearDepth = 1e-4f;
+
+        [[nodiscard]] inline Math::Vector2D perspectivePlane(const Math::Vector3D& p, float focalLength) noexcept {
+            const float scale = focalLength / std::max(-p.z, PerspectiveNearDepth);
+            return Math::Vector2D(p.x * scale, p.y * scale);
+        }
+
+        // Calls fn(toView, toPlane) with the projection resolved once, so per-vertex loops stay branch-free
+        template <typename Fn>
+        inline void withProjection(const ViewTransform* view, Fn&& fn) {
+            const auto orthographic = [](const Math::Vector3D& p) noexcept { return Math::orthographicProject(p); };
+            if (!view) {
+                fn([](const Math::Vector3D& p) noexcept { return p; }, orthographic);
+                return;
+            }
+            const Math::PointTransformer toView(view->view);
+            if (view->projection == Projection::Perspective) {
+                const float focalLength = view->focalLength;
+                fn(toView, [focalLength](const Math::Vector3D& p) noexcept { return perspectivePlane(p, focalLength); });
+            }
+            else {
+                fn(toView, orthographic);
+            }
+        }
+    }
+}
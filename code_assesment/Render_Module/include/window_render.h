@@ -26,6 +26,9 @@ namespace Render {
 
         bool initialized = false;
 
+        // Swaps a finished background load into place (or reports its error)
+        void FinishPendingLoad();
+
     public:
         // Constructor/destructor
         WindowRenderer(int width, int height, const std::wstring& title);
@@ -42,6 +45,7 @@ namespace Render {
         // Public interface
         void LoadObject(std::unique_ptr<WireframeObject> newObject);
         void LoadTetrahedron();
+        void LoadFile(const std::string& path); // Loads in the background; the current object stays until it finishes
         int Run();
         void Resize(int width, int height);
         void OpenFileDialog();
@@ -2,19 +2,58 @@
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <algorithm>
+#include <variant>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
 #include "renderable_objects.h"
 #include "vertex.h"
 #include "edge.h"
+#include "face.h"
 #include "matrix4x4.h"
+#include "trace.h"
+#include "mesh_change_log.h"
+#include "mesh_bounds.h"
 
 namespace Render {
     // Forward declaration
     class Renderer;
 
     class WireframeObject : public IRenderable {
+    public:
+        enum class EdgeIndexWidth { Bits16, Bits32, BitsWide };
+
     private:
+        // Edges are stored with the narrowest index type that fits; addEdge widens on demand
+        using EdgeStorage = std::variant<std::vector<Edge16>, std::vector<Edge32>, std::vector<EdgeWide>>;
+
         std::vector<Vertex> vertices;
-        std::vector<Edge> edges;
+        EdgeStorage edges;
+        std::vector<Face> faces; // Optional; only used for hidden-line removal
+        std::size_t edgeIndexLimit = 0; // One past the largest vertex index referenced by an edge
+        MeshChangeLog changeLog;
+        uint64_t positionsRevision = 0; // Change log revision of the last vertex edit
+        mutable MeshBoundsCache boundsCache;
+
+        void recordVertexChange(MeshChangeKind kind, std::size_t begin, std::size_t end) noexcept {
+            changeLog.record(kind, begin, end);
+            positionsRevision = changeLog.getRevision();
+        }
+
+        template <typename Target>
+        [[nodiscard]] std::vector<Target> convertEdges() const {
+            using Index = typename Target::IndexType;
+            std::vector<Target> converted;
+            visitEdges([&converted](auto current) {
+                converted.reserve(current.size());
+                for (const auto& e : current) {
+                    converted.emplace_back(static_cast<Index>(e.getVertex1Index()), static_cast<Index>(e.getVertex2Index()));
+                }
+            });
+            return converted;
+        }
 
     public:
         WireframeObject() noexcept = default;
@@ -27,24 +66,289 @@ namespace Render {
 
         void addVertex(const Vertex& vertex) {
             vertices.push_back(vertex);
+            recordVertexChange(MeshChangeKind::VerticesAppended, vertices.size() - 1, vertices.size());
+        }
+
+        void reserveVertices(std::size_t vertexCount) {
+            vertices.reserve(vertexCount);
+        }
+
+        // Compared in 64 bits: with a 32-bit size_t, "uint32 max + 1" would wrap to 0
+        [[nodiscard]] static EdgeIndexWidth narrowestIndexWidth(std::size_t indexLimit) noexcept {
+            const uint64_t limit = indexLimit;
+            if (limit <= uint64_t{ (std::numeric_limits<uint16_t>::max)() } + 1) return EdgeIndexWidth::Bits16;
+            if (limit <= uint64_t{ (std::numeric_limits<uint32_t>::max)() } + 1) return EdgeIndexWidth::Bits32;
+            return EdgeIndexWidth::BitsWide;
+        }
+
+        // Re-encode existing edges with at least 'width' bits per index
+        void widenEdges(EdgeIndexWidth width) {
+            if (width <= getEdgeIndexWidth()) return;
+
+            if (width == EdgeIndexWidth::Bits32) {
+                edges = convertEdges<Edge32>();
+            }
+            else {
+                edges = convertEdges<EdgeWide>();
+            }
+        }
+
+        // Pick the index width up front (e.g. from a file header) and reserve storage
+        void reserveEdges(std::size_t edgeCount, std::size_t vertexCount) {
+            widenEdges(narrowestIndexWidth(vertexCount));
+            std::visit([edgeCount](auto& storage) { storage.reserve(edgeCount); }, edges);
+        }
+
+    private:
+        // One past the larger index of 'edge'; SIZE_MAX has no such limit and is rejected
+        [[nodiscard]] static std::size_t indexLimitOf(const Edge& edge) {
+            const std::size_t largest = std::max(edge.getVertex1Index(), edge.getVertex2Index());
+            if (largest == std::numeric_limits<std::size_t>::max()) {
+                throw std::out_of_range("Edge vertex index out of range");
+            }
+            return largest + 1;
         }
 
+        // 'source' encoded with the narrowest index type for 'indexLimit'
+        [[nodiscard]] static EdgeStorage encodeEdges(std::span<const Edge> source, std::size_t indexLimit) {
+            EdgeStorage storage;
+            switch (narrowestIndexWidth(indexLimit)) {
+            case EdgeIndexWidth::Bits16: storage.emplace<std::vector<Edge16>>(); break;
+            case EdgeIndexWidth::Bits32: storage.emplace<std::vector<Edge32>>(); break;
+            default: storage.emplace<std::vector<EdgeWide>>(); break;
+            }
+            std::visit([source](auto& target) {
+                using Index = typename std::decay_t<decltype(target)>::value_type::IndexType;
+                target.reserve(source.size());
+                for (const auto& e : source) {
+                    target.emplace_back(static_cast<Index>(e.getVertex1Index()), static_cast<Index>(e.getVertex2Index()));
+                }
+            }, storage);
+            return storage;
+        }
+
+        // Appends without recording a change
+        void storeEdge(const Edge& edge) {
+            const std::size_t limit = indexLimitOf(edge);
+            if (limit > edgeIndexLimit) {
+                widenEdges(narrowestIndexWidth(limit));
+                edgeIndexLimit = limit;
+            }
+
+            std::visit([&edge](auto& storage) {
+                using Index = typename std::decay_t<decltype(storage)>::value_type::IndexType;
+                storage.emplace_back(static_cast<Index>(edge.getVertex1Index()), static_cast<Index>(edge.getVertex2Index()));
+            }, edges);
+        }
+
+    public:
         void addEdge(const Edge& edge) {
-            edges.push_back(edge);
+            storeEdge(edge);
+            changeLog.record(MeshChangeKind::EdgesAppended, getEdgeCount() - 1, getEdgeCount());
+        }
+
+        // Every edge references an existing vertex; tracked on insertion so renderers can skip per-edge checks
+        [[nodiscard]] bool hasValidEdgeIndices() const noexcept {
+            return edgeIndexLimit <= vertices.size();
+        }
+
+        void addFace(const Face& face) {
+            faces.push_back(face);
+            changeLog.record(MeshChangeKind::FacesAppended, faces.size() - 1, faces.size());
+        }
+
+        void reserveFaces(std::size_t faceCount) {
+            faces.reserve(faceCount);
         }
 
         [[nodiscard]] const std::vector<Vertex>& getVertices() const noexcept {
             return vertices;
         }
 
-        [[nodiscard]] const std::vector<Edge>& getEdges() const noexcept {
-            return edges;
+        [[nodiscard]] EdgeIndexWidth getEdgeIndexWidth() const noexcept {
+            return static_cast<EdgeIndexWidth>(edges.index());
+        }
+
+        [[nodiscard]] std::size_t getEdgeCount() const noexcept {
+            return std::visit([](const auto& storage) { return storage.size(); }, edges);
+        }
+
+        [[nodiscard]] Edge getEdge(std::size_t i) const noexcept {
+            return std::visit([i](const auto& storage) {
+                return Edge(storage[i].getVertex1Index(), storage[i].getVertex2Index());
+            }, edges);
+        }
+
+        [[nodiscard]] std::size_t getEdgeMemoryBytes() const noexcept {
+            return std::visit([](const auto& storage) {
+                return storage.capacity() * sizeof(typename std::decay_t<decltype(storage)>::value_type);
+            }, edges);
+        }
+
+        // Calls fn(std::span<const BasicEdge<Index>>) with the edges in their stored width
+        template <typename Fn>
+        decltype(auto) visitEdges(Fn&& fn) const {
+            return std::visit([&fn](const auto& storage) -> decltype(auto) {
+                using EdgeType = typename std::decay_t<decltype(storage)>::value_type;
+                return fn(std::span<const EdgeType>(storage));
+            }, edges);
+        }
+
+        [[nodiscard]] const std::vector<Face>& getFaces() const noexcept {
+            return faces;
         }
 
         void transform(const Math::Matrix4x4& matrix) noexcept {
+            RENDER_TRACE_SCOPE("WireframeObject::transform");
+            const Math::PointTransformer transformer(matrix);
             for (auto& vertex : vertices) {
-                vertex.transform(matrix);
+                vertex.setPosition(transformer(vertex.getPosition()));
+            }
+            recordVertexChange(MeshChangeKind::VerticesUpdated, 0, vertices.size());
+        }
+
+        // p' = (p + offset) * scale in one pass; matches translating then scaling
+        void offsetAndScale(const Math::Vector3D& offset, float scale) noexcept {
+            RENDER_TRACE_SCOPE("WireframeObject::offsetAndScale");
+            for (auto& vertex : vertices) {
+                vertex.setPosition((vertex.getPosition() + offset) * scale);
+            }
+            recordVertexChange(MeshChangeKind::VerticesUpdated, 0, vertices.size());
+        }
+
+        // Cached; recomputed (in parallel for large meshes) on the first query after a vertex edit
+        [[nodiscard]] MeshBounds getBounds() const {
+            return boundsCache.get(changeLog.getMeshId(), positionsRevision, [this] { return computeMeshBounds(vertices); });
+        }
+
+        [[nodiscard]] Math::BoundingBox getBoundingBox() const {
+            return getBounds().box;
+        }
+
+        [[nodiscard]] Math::BoundingSphere getBoundingSphere() const {
+            return getBounds().sphere;
+        }
+
+        // Bulk edits for live geometry. Each records one MeshChange, so derived caches can update
+        // only the affected ranges (see getChangeLog and TransformedObjectCache).
+
+        // Returns the index of the first appended vertex
+        std::size_t appendVertices(std::span<const Vertex> newVertices) {
+            const std::size_t first = vertices.size();
+            vertices.insert(vertices.end(), newVertices.begin(), newVertices.end());
+            recordVertexChange(MeshChangeKind::VerticesAppended, first, vertices.size());
+            return first;
+        }
+
+        // Overwrites positions [first, first + positions.size())
+        void updateVertices(std::size_t first, std::span<const Math::Vector3D> positions) {
+            if (first > vertices.size() || positions.size() > vertices.size() - first) {
+                throw std::out_of_range("updateVertices: range exceeds the vertex count");
+            }
+            for (std::size_t i = 0; i < positions.size(); ++i) {
+                vertices[first + i].setPosition(positions[i]);
+            }
+            recordVertexChange(MeshChangeKind::VerticesUpdated, first, first + positions.size());
+        }
+
+        // Erases [first, first + count). Edges and faces touching the range are dropped and
+        // references to later vertices are shifted down.
+        void removeVertices(std::size_t first, std::size_t count) {
+            if (first > vertices.size() || count > vertices.size() - first) {
+                throw std::out_of_range("removeVertices: range exceeds the vertex count");
+            }
+            if (count == 0) return;
+
+            const std::size_t last = first + count;
+            const auto remap = [first, last, count](std::size_t index) noexcept {
+                return (index < first) ? index : (index >= last) ? index - count : std::numeric_limits<std::size_t>::max();
+            };
+            constexpr std::size_t removed = std::numeric_limits<std::size_t>::max();
+
+            // Everything that can throw builds locals; the object is only changed once they all exist
+            std::vector<Edge> keptEdges;
+            keptEdges.reserve(getEdgeCount());
+            std::size_t keptLimit = 0;
+            visitEdges([&](auto current) {
+                for (const auto& e : current) {
+                    const std::size_t a = remap(e.getVertex1Index());
+                    const std::size_t b = remap(e.getVertex2Index());
+                    if (a != removed && b != removed) {
+                        keptEdges.emplace_back(a, b);
+                        keptLimit = std::max({ keptLimit, a + 1, b + 1 });
+                    }
+                }
+            });
+            EdgeStorage keptStorage = encodeEdges(keptEdges, keptLimit);
+
+            std::vector<Face> keptFaces;
+            keptFaces.reserve(faces.size());
+            for (const auto& face : faces) {
+                const std::size_t a = remap(face.getVertex1Index());
+                const std::size_t b = remap(face.getVertex2Index());
+                const std::size_t c = remap(face.getVertex3Index());
+                if (a != removed && b != removed && c != removed) keptFaces.emplace_back(a, b, c);
+            }
+
+            vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(first), vertices.begin() + static_cast<std::ptrdiff_t>(last));
+            faces.swap(keptFaces);
+            edges.swap(keptStorage);
+            edgeIndexLimit = keptLimit;
+            recordVertexChange(MeshChangeKind::VerticesRemoved, first, last);
+        }
+
+        // Returns the index of the first appended edge
+        std::size_t appendEdges(std::span<const Edge> newEdges) {
+            const std::size_t first = getEdgeCount();
+            std::size_t limit = edgeIndexLimit;
+            for (const auto& e : newEdges) {
+                limit = std::max(limit, indexLimitOf(e));
+            }
+            reserveEdges(first + newEdges.size(), limit);
+            for (const auto& e : newEdges) {
+                storeEdge(e);
             }
+            changeLog.record(MeshChangeKind::EdgesAppended, first, getEdgeCount());
+            return first;
+        }
+
+        // Erases edges [first, first + count); later edges shift down
+        void removeEdges(std::size_t first, std::size_t count) {
+            if (first > getEdgeCount() || count > getEdgeCount() - first) {
+                throw std::out_of_range("removeEdges: range exceeds the edge count");
+            }
+            std::visit([first, count](auto& storage) {
+                storage.erase(storage.begin() + static_cast<std::ptrdiff_t>(first),
+                    storage.begin() + static_cast<std::ptrdiff_t>(first + count));
+            }, edges);
+            changeLog.record(MeshChangeKind::EdgesRemoved, first, first + count);
+        }
+
+        // Replaces the whole mesh with generated geometry. Storage is sized up front (edges with the
+        // narrowest index type for 'vertexCount') and fill(std::span<Vertex>, std::span<BasicEdge<Index>>,
+        // std::span<Face>) overwrites every element in place, possibly from several threads. Every index
+        // written must be below 'vertexCount'. Records a Reset.
+        template <typename Fill>
+        void assignGenerated(std::size_t vertexCount, std::size_t edgeCount, std::size_t faceCount, Fill&& fill) {
+            vertices.assign(vertexCount, Vertex(0.0f, 0.0f, 0.0f));
+            faces.assign(faceCount, Face(0, 0, 0));
+            edges = EdgeStorage{};
+            widenEdges(narrowestIndexWidth(vertexCount));
+            std::visit([&](auto& storage) {
+                using EdgeType = typename std::decay_t<decltype(storage)>::value_type;
+                storage.assign(edgeCount, EdgeType(0, 0));
+                fill(std::span<Vertex>(vertices), std::span<EdgeType>(storage), std::span<Face>(faces));
+            }, edges);
+            edgeIndexLimit = vertexCount;
+            recordVertexChange(MeshChangeKind::Reset, 0, vertexCount);
+        }
+
+        [[nodiscard]] const MeshChangeLog& getChangeLog() const noexcept {
+            return changeLog;
+        }
+
+        [[nodiscard]] uint64_t getRevision() const noexcept {
+            return changeLog.getRevision();
         }
 
         // IRenderable implementation
@@ -72,6 +376,12 @@ namespace Render {
             tetrahedron->addEdge(Edge(1, 3)); // Bottom left to bottom back
             tetrahedron->addEdge(Edge(2, 3)); // Bottom right to bottom back
 
+            // Define faces
+            tetrahedron->addFace(Face(0, 1, 2));
+            tetrahedron->addFace(Face(0, 2, 3));
+            tetrahedron->addFace(Face(0, 3, 1));
+            tetrahedron->addFace(Face(1, 3, 2));
+
             return tetrahedron;
         }
     };
@@ -0,0 +1,57 @@
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> globalAllocations{ 0 };
+    thread_local uint64_t threadAllocations = 0;
+}
+
+namespace Render {
+    namespace AllocationCounter {
+        bool isEnabled() noexcept {
+#ifdef RENDER_COUNT_ALLOCATIONS
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        uint64_t threadCount() noexcept {
+            return threadAllocations;
+        }
+
+        uint64_t globalCount() noexcept {
+            return globalAllocations.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+#ifdef RENDER_COUNT_ALLOCATIONS
+namespace {
+    void* countedAllocate(std::size_t size) {
+        globalAllocations.fetch_add(1, std::memory_order_relaxed);
+        ++threadAllocations;
+        if (void* p = std::malloc(size ? size : 1)) {
+            return p;
+        }
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); }
+    catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); }
+    catch (...) { return nullptr; }
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#endif
@@ -0,0 +1,477 @@
+#include "batch_render.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "framebuffer.h"
+#include "frame_encoder.h"
+#include "video_stream_sink.h"
+#include "object_loader.h"
+#include "poster_render.h"
+#include "transformation.h"
+#include "transformed_object_cache.h"
+#include "trace.h"
+
+namespace Render {
+    Math::Matrix4x4 CameraPath::matrixAt(int frame, int frameCount, float fitDistance) const {
+        const int steps = loop ? frameCount : frameCount - 1;
+        const float t = (steps > 0) ? static_cast<float>(frame) / static_cast<float>(steps) : 0.0f;
+
+        // Pitch about X, then yaw about Y, then pull back along -Z
+        Math::TransformationPipeline pipeline;
+        pipeline.addRotationX(startPitch + (endPitch - startPitch) * t);
+        pipeline.addRotationY(startYaw + (endYaw - startYaw) * t);
+        pipeline.addTranslation(0.0f, 0.0f, -(distance > 0.0f ? distance : fitDistance));
+        return pipeline.getTransformMatrix();
+    }
+
+    CameraPath CameraPath::fixed(float yawDegrees, float pitchDegrees, float distance) noexcept {
+        CameraPath path;
+        path.startYaw = path.endYaw = yawDegrees * DegreesToRadians;
+        path.startPitch = path.endPitch = pitchDegrees * DegreesToRadians;
+        path.distance = distance;
+        path.loop = false;
+        return path;
+    }
+
+    namespace BatchSpec {
+        namespace {
+            [[noreturn]] void fail(int line, const std::string& message) {
+                throw std::runtime_error("Job spec line " + std::to_string(line) + ": " + message);
+            }
+
+            int parseInt(const std::string& value, int line, const std::string& key, int minimum) {
+                try {
+                    size_t used = 0;
+                    const int result = std::stoi(value, &used);
+                    if (used == value.size() && result >= minimum) return result;
+                }
+                catch (const std::exception&) {
+                }
+                fail(line, "invalid value for '" + key + "': " + value);
+            }
+
+            float parseFloat(const std::string& value, int line, const std::string& key) {
+                try {
+                    size_t used = 0;
+                    const float result = std::stof(value, &used);
+                    if (used == value.size() && std::isfinite(result)) return result;
+                }
+                catch (const std::exception&) {
+                }
+                fail(line, "invalid value for '" + key + "': " + value);
+            }
+
+            // "<deg>" or "<start>:<end>" in degrees
+            void parseAngles(const std::string& value, int line, const std::string& key, float& start, float& end) {
+                const size_t colon = value.find(':');
+                start = parseFloat(value.substr(0, colon), line, key) * CameraPath::DegreesToRadians;
+                end = (colon == std::string::npos) ? start : parseFloat(value.substr(colon + 1), line, key) * CameraPath::DegreesToRadians;
+            }
+
+            bool parseBool(const std::string& value, int line, const std::string& key) {
+                if (value == "1" || value == "true") return true;
+                if (value == "0" || value == "false") return false;
+                fail(line, "invalid value for '" + key + "': " + value);
+            }
+        }
+
+        std::vector<BatchJob> parse(std::istream& in) {
+            std::vector<BatchJob> jobs;
+            std::string text;
+            int lineNumber = 0;
+
+            while (std::getline(in, text)) {
+                ++lineNumber;
+                const size_t comment = text.find('#');
+                if (comment != std::string::npos) text.erase(comment);
+
+                std::istringstream tokens(text);
+                std::string token;
+                BatchJob job;
+                bool any = false;
+                bool yawGiven = false;
+
+                while (tokens >> token) {
+                    any = true;
+                    const size_t equals = token.find('=');
+                    if (equals == std::string::npos || equals == 0) {
+                        fail(lineNumber, "expected key=value, got '" + token + "'");
+                    }
+                    const std::string key = token.substr(0, equals);
+                    const std::string value = token.substr(equals + 1);
+
+                    if (key == "mesh") {
+                        job.meshPath = value;
+                    }
+                    else if (key == "out") {
+                        job.outputPrefix = value;
+                    }
+                    else if (key == "size") {
+                        const size_t x = value.find('x');
+                        if (x == std::string::npos) fail(lineNumber, "size must be <width>x<height>");
+                        job.width = parseInt(value.substr(0, x), lineNumber, key, 1);
+                        job.height = parseInt(value.substr(x + 1), lineNumber, key, 1);
+                    }
+                    else if (key == "frames") {
+                        job.frameCount = parseInt(value, lineNumber, key, 1);
+                    }
+                    else if (key == "format") {
+                        if (value == "ppm") job.format = BatchOutputFormat::PPM;
+                        else if (value == "qoi") job.format = BatchOutputFormat::QOI;
+                        else if (value == "y4m") job.format = BatchOutputFormat::Y4M;
+                        else fail(lineNumber, "unknown format: " + value);
+                    }
+                    else if (key == "yaw") {
+                        parseAngles(value, lineNumber, key, job.camera.startYaw, job.camera.endYaw);
+                        yawGiven = true;
+                    }
+                    else if (key == "pitch") {
+                        parseAngles(value, lineNumber, key, job.camera.startPitch, job.camera.endPitch);
+                    }
+                    else if (key == "distance") {
+                        job.camera.distance = parseFloat(value, lineNumber, key);
+                    }
+                    else if (key == "loop") {
+                        job.camera.loop = parseBool(value, lineNumber, key);
+                    }
+                    else if (key == "lines") {
+                        if (value == "aliased") job.lineMode = LineMode::Aliased;
+                        else if (value == "aa") job.lineMode = LineMode::AntiAliased;
+                        else if (value == "subpixel") job.lineMode = LineMode::SubPixel;
+                        else fail(lineNumber, "unknown line mode: " + value);
+                    }
+                    else if (key == "hidden") {
+                        job.hiddenLines = parseBool(value, lineNumber, key);
+                    }
+                    else if (key == "radius") {
+                        job.vertexRadius = parseInt(value, lineNumber, key, 0);
+                    }
+                    else if (key == "band") {
+                        job.bandHeight = parseInt(value, lineNumber, key, 1);
+                    }
+                    else {
+                        fail(lineNumber, "unknown key: " + key);
+                    }
+                }
+
+                if (!any) continue;
+                if (job.meshPath.empty()) fail(lineNumber, "missing mesh=");
+                if (job.bandHeight > 0 && (job.format != BatchOutputFormat::PPM || job.lineMode != LineMode::Aliased || job.hiddenLines)) {
+                    fail(lineNumber, "band= needs format=ppm, lines=aliased and hidden=0");
+                }
+                if (job.outputPrefix.empty()) {
+                    std::string stem = job.meshPath;
+                    const size_t dot = stem.find_last_of('.');
+                    const size_t slash = stem.find_last_of("/\\");
+                    if (dot != std::string::npos && (slash == std::string::npos || dot > slash)) stem.erase(dot);
+                    job.outputPrefix = stem;
+                }
+                // A single yaw angle means a fixed view rather than a full turn
+                if (yawGiven && job.camera.startYaw == job.camera.endYaw) job.camera.loop = false;
+                jobs.push_back(std::move(job));
+            }
+            return jobs;
+        }
+
+        std::vector<BatchJob> loadFile(const std::string& filename) {
+            std::ifstream file(filename);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open job spec: " + filename);
+            }
+            return parse(file);
+        }
+    }
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        [[nodiscard]] double secondsBetween(Clock::time_point start, Clock::time_point end) noexcept {
+            return std::chrono::duration<double>(end - start).count();
+        }
+
+        // Viewer framing (see WindowRenderer::AdjustViewForObject)
+        [[nodiscard]] float fitDistance(const WireframeObject& object) {
+            if (object.getVertices().empty()) return 5.0f;
+            return std::max(3.0f, object.getBoundingSphere().reachFromOrigin() * 2.5f);
+        }
+
+        struct FileCloser {
+            void operator()(std::FILE* file) const noexcept {
+                std::fclose(file);
+            }
+        };
+
+        // Shared between the workers rendering one job
+        struct JobState {
+            std::once_flag loadOnce;
+            std::shared_ptr<const WireframeObject> mesh; // Set once by the loader; reset after the last frame
+            float distance = 0.0f;
+            bool loadFailed = false;
+            Clock::time_point start;
+
+            std::unique_ptr<std::FILE, FileCloser> streamFile; // Declared before the sink that writes to it
+            std::unique_ptr<VideoStreamSink> stream;
+
+            std::mutex mutex; // Guards everything below
+            std::condition_variable streamTurn;
+            int nextStreamFrame = 0;
+            int framesLeft = 0;
+            BatchJobResult result;
+        };
+
+        // Per-thread render state, reused across frames and jobs
+        struct Worker {
+            std::shared_ptr<FrameBuffer> frameBuffer;
+            std::unique_ptr<Renderer> renderer;
+            std::shared_ptr<RenderStats> stats; // Null unless the batch collects stats
+            TransformedObjectCache transformed;
+            std::vector<uint8_t> encoded;
+            std::string filename;
+
+            Renderer& rendererFor(int width, int height) {
+                if (!frameBuffer || frameBuffer->getWidth() != width || frameBuffer->getHeight() != height) {
+                    frameBuffer = std::make_shared<FrameBuffer>(width, height);
+                    renderer = std::make_unique<Renderer>(frameBuffer);
+                    renderer->setStats(stats);
+                }
+                return *renderer;
+            }
+        };
+
+        void loadJob(const BatchJob& job, JobState& state) {
+            RENDER_TRACE_SCOPE("BatchRenderer::loadJob");
+            state.start = Clock::now();
+            try {
+                ObjectLoader loader;
+                std::shared_ptr<const WireframeObject> mesh = loader.loadFromFile(job.meshPath);
+                state.distance = fitDistance(*mesh);
+
+                if (job.format == BatchOutputFormat::Y4M) {
+                    const std::string path = job.outputPrefix + ".y4m";
+                    state.streamFile.reset(std::fopen(path.c_str(), "wb"));
+                    if (!state.streamFile) {
+                        throw std::runtime_error("Failed to open output: " + path);
+                    }
+                    state.stream = std::make_unique<VideoStreamSink>(job.width, job.height, state.streamFile.get(), StreamFormat::Y4M);
+                }
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.result.vertexCount = mesh->getVertices().size();
+                state.result.edgeCount = mesh->getEdgeCount();
+                state.mesh = std::move(mesh);
+            }
+            catch (const std::exception& e) {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.result.error = e.what();
+                state.loadFailed = true;
+            }
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.result.loadSeconds = secondsBetween(state.start, Clock::now());
+        }
+
+        bool writeImage(const BatchJob& job, int frame, Worker& worker) {
+            RENDER_TRACE_SCOPE("BatchRenderer::writeImage");
+            static const PPMEncoder ppm;
+            static const QOIEncoder qoi;
+            const IFrameEncoder& encoder = (job.format == BatchOutputFormat::PPM)
+                ? static_cast<const IFrameEncoder&>(ppm) : static_cast<const IFrameEncoder&>(qoi);
+
+            char number[16];
+            std::snprintf(number, sizeof(number), "_%d.", frame);
+            worker.filename.assign(job.outputPrefix).append(number).append(encoder.extension());
+
+            worker.encoded.clear();
+            encoder.encode(worker.frameBuffer->getPixels().data(), job.width, job.height, worker.encoded);
+
+            std::ofstream file(worker.filename, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(worker.encoded.data()), static_cast<std::streamsize>(worker.encoded.size()));
+            return static_cast<bool>(file);
+        }
+
+        // Frames too large for a FrameBuffer: the camera is applied during projection instead of
+        // transforming a copy of the mesh, and bands are streamed straight to the PPM file
+        bool renderBandedFrame(const BatchJob& job, const JobState& state, int frame, Worker& worker) {
+            PosterOptions options;
+            options.width = job.width;
+            options.height = job.height;
+            options.bandHeight = job.bandHeight;
+            options.maxWorkers = 1; // The batch already runs one worker per core; nested band workers would multiply them
+            options.vertexRadius = job.vertexRadius;
+            options.color = job.color;
+            options.background = job.background;
+
+            char number[16];
+            std::snprintf(number, sizeof(number), "_%d.ppm", frame);
+            worker.filename.assign(job.outputPrefix).append(number);
+
+            const ViewTransform camera{ job.camera.matrixAt(frame, job.frameCount, state.distance) };
+            return PosterRenderer(options).render(*state.mesh, &camera, worker.filename).error.empty();
+        }
+
+        // Renders and writes one frame; false when the frame could not be produced
+        bool renderFrame(const BatchJob& job, JobState& state, int frame, Worker& worker) {
+            RENDER_TRACE_SCOPE("BatchRenderer::renderFrame");
+            if (state.loadFailed) return false;
+
+            if (job.bandHeight > 0) {
+                return renderBandedFrame(job, state, frame, worker);
+            }
+
+            Renderer& renderer = worker.rendererFor(job.width, job.height);
+            renderer.setLineMode(job.lineMode);
+            renderer.setHiddenLineRemoval(job.hiddenLines);
+            renderer.beginFrame();
+            renderer.clear(job.background);
+            {
+                ScopedStageTimer timer(worker.stats.get(), RenderStage::Transform);
+                worker.transformed.update(*state.mesh, job.camera.matrixAt(frame, job.frameCount, state.distance));
+            }
+            renderer.drawWireframeObject(worker.transformed.get(), job.vertexRadius, job.color);
+            renderer.endFrame();
+
+            // Y4M frames are appended by appendStreamFrame once it is this frame's turn
+            return job.format == BatchOutputFormat::Y4M || writeImage(job, frame, worker);
+        }
+
+        // Stream frames must be appended in order and every frame takes its turn, rendered or not;
+        // a frame that skipped its turn would block all later frames of the job forever
+        bool appendStreamFrame(JobState& state, int frame, const Worker& worker, bool rendered) {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.streamTurn.wait(lock, [&] { return state.nextStreamFrame == frame; });
+            bool written = false;
+            if (rendered) {
+                try {
+                    written = state.stream->writeFrame(*worker.frameBuffer);
+                }
+                catch (const std::exception& e) {
+                    if (state.result.error.empty()) state.result.error = e.what();
+                }
+            }
+            ++state.nextStreamFrame;
+            lock.unlock();
+            state.streamTurn.notify_all();
+            return written;
+        }
+    }
+
+    BatchRenderer::BatchRenderer(unsigned workers) noexcept
+        : workerCount(workers ? workers : std::max(1u, std::thread::hardware_concurrency())) {
+    }
+
+    std::vector<BatchJobResult> BatchRenderer::run(const std::vector<BatchJob>& jobs, RenderStats* stats) const {
+        RENDER_TRACE_SCOPE("BatchRenderer::run");
+
+        // Flatten (job, frame) pairs into one index space claimed in order
+        std::vector<size_t> firstFrame(jobs.size() + 1, 0);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            firstFrame[i + 1] = firstFrame[i] + static_cast<size_t>(std::max(jobs[i].frameCount, 0));
+        }
+        const size_t totalFrames = firstFrame.back();
+
+        std::vector<std::unique_ptr<JobState>> states;
+        states.reserve(jobs.size());
+        for (const auto& job : jobs) {
+            auto state = std::make_unique<JobState>();
+            state->framesLeft = std::max(job.frameCount, 0);
+            state->result.meshPath = job.meshPath;
+            states.push_back(std::move(state));
+        }
+
+        // RenderStats is not thread-safe, so each worker records into its own and they are merged at the end
+        const unsigned threadCount = static_cast<unsigned>(std::min<size_t>(workerCount, std::max<size_t>(totalFrames, 1)));
+        std::vector<std::shared_ptr<RenderStats>> workerStats(stats ? threadCount : 0);
+        for (auto& collector : workerStats) {
+            collector = std::make_shared<RenderStats>(stats->getWindowSize());
+        }
+
+        std::atomic<size_t> nextFrame{ 0 };
+        const auto workerLoop = [&](unsigned workerIndex) {
+            RENDER_TRACE_THREAD_NAME("batch");
+            Worker worker;
+            if (stats) worker.stats = workerStats[workerIndex];
+            size_t jobIndex = 0;
+
+            for (size_t global = nextFrame.fetch_add(1, std::memory_order_relaxed); global < totalFrames;
+                global = nextFrame.fetch_add(1, std::memory_order_relaxed)) {
+                // Claims only move forward, so the job search resumes where the last one ended
+                while (firstFrame[jobIndex + 1] <= global) ++jobIndex;
+                const BatchJob& job = jobs[jobIndex];
+                JobState& state = *states[jobIndex];
+                const int frame = static_cast<int>(global - firstFrame[jobIndex]);
+
+                std::call_once(state.loadOnce, loadJob, std::cref(job), std::ref(state));
+
+                const auto frameStart = Clock::now();
+                bool rendered = false;
+                try {
+                    rendered = renderFrame(job, state, frame, worker);
+                }
+                catch (const std::exception& e) {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    if (state.result.error.empty()) state.result.error = e.what();
+                }
+                if (state.stream) {
+                    rendered = appendStreamFrame(state, frame, worker, rendered);
+                }
+                const auto frameEnd = Clock::now();
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                (rendered ? state.result.framesRendered : state.result.framesFailed)++;
+                state.result.renderSeconds += secondsBetween(frameStart, frameEnd);
+                if (--state.framesLeft == 0) {
+                    state.result.wallSeconds = secondsBetween(state.start, frameEnd);
+                    state.mesh.reset();
+                    state.stream.reset();
+                    state.streamFile.reset();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (unsigned i = 1; i < threadCount; ++i) {
+            threads.emplace_back(workerLoop, i);
+        }
+        workerLoop(0);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& collector : workerStats) {
+            stats->merge(*collector);
+        }
+
+        std::vector<BatchJobResult> results;
+        results.reserve(states.size());
+        for (auto& state : states) {
+            results.push_back(std::move(state->result));
+        }
+        return results;
+    }
+
+    void BatchRenderer::writeReport(std::ostream& out, const std::vector<BatchJobResult>& results, double wallSeconds) {
+        out << "mesh\tframes\tfailed\tvertices\tedges\tload_s\trender_s\twall_s\tfps\terror\n";
+        int frames = 0;
+        int failed = 0;
+        char numbers[128];
+        for (const auto& r : results) {
+            std::snprintf(numbers, sizeof(numbers), "%d\t%d\t%zu\t%zu\t%.3f\t%.3f\t%.3f\t%.1f",
+                r.framesRendered, r.framesFailed, r.vertexCount, r.edgeCount,
+                r.loadSeconds, r.renderSeconds, r.wallSeconds, r.framesPerSecond());
+            out << r.meshPath << '\t' << numbers << '\t' << r.error << '\n';
+            frames += r.framesRendered;
+            failed += r.framesFailed;
+        }
+        std::snprintf(numbers, sizeof(numbers), "%zu jobs, %d frames (%d failed) in %.3f s, %.1f frames/s",
+            results.size(), frames, failed, wallSeconds, wallSeconds > 0.0 ? frames / wallSeconds : 0.0);
+        out << "# total: " << numbers << '\n';
+    }
+}
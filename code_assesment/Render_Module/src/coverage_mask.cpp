@@ -0,0 +1,95 @@
+#include "coverage_mask.h"
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+#include <limits>
+
+namespace Render {
+    namespace {
+        [[nodiscard]] bool sameColor(const Color& a, const Color& b) noexcept {
+            return a.r == b.r && a.g == b.g && a.b == b.b;
+        }
+
+        [[nodiscard]] int colorDistance(const Color& a, const Color& b) noexcept {
+            const int dr = a.r - b.r, dg = a.g - b.g, db = a.b - b.b;
+            return dr * dr + dg * dg + db * db;
+        }
+    }
+
+    CoverageMaskTarget::CoverageMaskTarget(int width, int height, int bitsPerPixel)
+        : width(std::max(width, 0)), height(std::max(height, 0)), bitsPerPixel(bitsPerPixel) {
+        if (bitsPerPixel != 1 && bitsPerPixel != 2 && bitsPerPixel != 4) {
+            throw std::invalid_argument("CoverageMaskTarget: bitsPerPixel must be 1, 2 or 4");
+        }
+        pixelsPerWordShift = 6 - (bitsPerPixel == 1 ? 0 : bitsPerPixel == 2 ? 1 : 2);
+        wordsPerRow = (static_cast<size_t>(this->width) * bitsPerPixel + 63) / 64;
+        words.assign(wordsPerRow * static_cast<size_t>(this->height), 0);
+
+        palette.fill(Color::Black());
+        const Color defaults[] = { Color::Black(), Color::Blue(), Color::White(), Color::Red(), Color::Green() };
+        std::copy_n(defaults, std::min<size_t>(std::size(defaults), static_cast<size_t>(getPaletteSize())), palette.begin());
+        lastColor = palette[0];
+    }
+
+    uint8_t CoverageMaskTarget::paletteIndexOf(const Color& color) noexcept {
+        if (sameColor(color, lastColor)) return lastIndex;
+
+        uint8_t best = 0;
+        if (!sameColor(color, palette[0])) {
+            // Anything but the background is coverage, even when it is nearer the background colour.
+            // Entries that repeat the background would hide the write, so they are only a last resort.
+            best = 1;
+            int bestDistance = (std::numeric_limits<int>::max)();
+            for (int i = 1; i < getPaletteSize() && bestDistance > 0; ++i) {
+                if (sameColor(palette[i], palette[0])) continue;
+                const int distance = colorDistance(color, palette[i]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = static_cast<uint8_t>(i);
+                }
+            }
+        }
+        lastColor = color;
+        lastIndex = best;
+        return best;
+    }
+
+    void CoverageMaskTarget::clear(const Color& color) noexcept {
+        palette[0] = color;
+        std::fill(words.begin(), words.end(), uint64_t{ 0 });
+        lastColor = color;
+        lastIndex = 0;
+    }
+
+    void CoverageMaskTarget::setPaletteColor(int index, const Color& color) noexcept {
+        if (index < 0 || index >= getPaletteSize()) return;
+        palette[index] = color;
+        // The cached mapping may now point at a different nearest entry
+        lastColor = palette[0];
+        lastIndex = 0;
+    }
+
+    void CoverageMaskTarget::copyToLinear(Color* out) const noexcept {
+        const int pixelsPerWord = 1 << pixelsPerWordShift;
+        const uint64_t indexMask = (uint64_t{ 1 } << bitsPerPixel) - 1;
+        const Color background = palette[0];
+
+        for (int y = 0; y < height; ++y) {
+            const uint64_t* row = words.data() + static_cast<size_t>(y) * wordsPerRow;
+            Color* dst = out + static_cast<size_t>(y) * width;
+            for (size_t w = 0; w < wordsPerRow; ++w) {
+                const int first = static_cast<int>(w) << pixelsPerWordShift;
+                const int count = std::min(pixelsPerWord, width - first);
+                uint64_t word = row[w];
+                if (word == 0) {
+                    std::fill(dst + first, dst + first + count, background);
+                    continue;
+                }
+                for (int i = 0; i < count; ++i) {
+                    dst[first + i] = palette[word & indexMask];
+                    word >>= bitsPerPixel;
+                }
+            }
+        }
+    }
+}
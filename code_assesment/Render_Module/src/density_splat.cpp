@@ -0,0 +1,119 @@
+#include "density_splat.h"
+#include <algorithm>
+#include <cmath>
+#include "framebuffer.h"
+#include "parallel_for.h"
+#include "trace.h"
+
+namespace Render {
+    namespace {
+        // Counts up to this many get a precomputed colour; denser pixels are mapped individually
+        constexpr uint32_t ToneTableSize = 4096;
+
+        template <typename ToView, typename ToPlane>
+        void countPoints(std::span<const Vertex> points, uint32_t* counts, int width, int height,
+            ToView&& toView, ToPlane&& toPlane) noexcept {
+            // Same arithmetic as Renderer::projectPoints, so splats land on the vertex pixels
+            const float halfWidth = static_cast<float>(width) / 2.0f;
+            const float halfHeight = static_cast<float>(height) / 2.0f;
+            const float maxX = static_cast<float>(width);
+            const float maxY = static_cast<float>(height);
+            for (const auto& point : points) {
+                const Math::Vector2D p = toPlane(toView(point.getPosition()));
+                const float screenX = (p.x + 1.0f) * halfWidth;
+                const float screenY = (1.0f - p.y) * halfHeight;
+                // Written so NaN fails the test
+                if (screenX >= 0.0f && screenX < maxX && screenY >= 0.0f && screenY < maxY) {
+                    ++counts[static_cast<size_t>(static_cast<int>(screenY)) * width + static_cast<int>(screenX)];
+                }
+            }
+        }
+
+        [[nodiscard]] Color toneColor(uint32_t count, const DensitySplatOptions& options, float scale) noexcept {
+            if (count == 0) return options.background;
+            const float value = (options.toneMap == DensityToneMap::Logarithmic)
+                ? std::log1p(static_cast<float>(count)) * scale
+                : static_cast<float>(count) * scale;
+            const float t = std::min(value, 1.0f);
+            const auto mix = [t](uint8_t a, uint8_t b) noexcept {
+                return static_cast<uint8_t>(static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t + 0.5f);
+            };
+            return Color(mix(options.low.r, options.high.r), mix(options.low.g, options.high.g), mix(options.low.b, options.high.b));
+        }
+    }
+
+    void DensitySplatter::accumulate(std::span<const Vertex> points, int newWidth, int newHeight, const ViewTransform* view) {
+        RENDER_TRACE_SCOPE("DensitySplatter::accumulate");
+        width = std::max(newWidth, 0);
+        height = std::max(newHeight, 0);
+        const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+
+        const size_t chunks = parallelChunkCount(points.size(), ChunkPoints);
+        counts.assign(pixelCount, 0);
+        if (workerCounts.size() < chunks - 1) {
+            workerCounts.resize(chunks - 1);
+        }
+        for (size_t c = 0; c + 1 < chunks; ++c) {
+            workerCounts[c].assign(pixelCount, 0);
+        }
+
+        Detail::withProjection(view, [&](auto&& toView, auto&& toPlane) {
+            parallelChunks(points.size(), ChunkPoints, [&](size_t chunk, size_t begin, size_t end) {
+                uint32_t* target = (chunk == 0) ? counts.data() : workerCounts[chunk - 1].data();
+                countPoints(points.subspan(begin, end - begin), target, width, height, toView, toPlane);
+            });
+        });
+
+        // Merge the per-thread counts, splitting the image between threads
+        if (chunks > 1) {
+            parallelChunks(pixelCount, ChunkPoints, [&](size_t, size_t begin, size_t end) {
+                for (size_t c = 0; c + 1 < chunks; ++c) {
+                    const uint32_t* source = workerCounts[c].data();
+                    for (size_t i = begin; i < end; ++i) {
+                        counts[i] += source[i];
+                    }
+                }
+            });
+        }
+
+        maxCount = counts.empty() ? 0 : *std::max_element(counts.begin(), counts.end());
+    }
+
+    void DensitySplatter::resolve(IRenderTarget& target, const DensitySplatOptions& options) {
+        RENDER_TRACE_SCOPE("DensitySplatter::resolve");
+        const uint32_t saturation = std::max<uint32_t>(options.saturation ? options.saturation : maxCount, 1);
+        const float scale = (options.toneMap == DensityToneMap::Logarithmic)
+            ? 1.0f / std::log1p(static_cast<float>(saturation))
+            : 1.0f / static_cast<float>(saturation);
+
+        // One colour per small count; most pixels of a cloud hold few points
+        const uint32_t tableSize = std::min(ToneTableSize, maxCount + 1);
+        toneTable.resize(tableSize);
+        for (uint32_t c = 0; c < tableSize; ++c) {
+            toneTable[c] = toneColor(c, options, scale);
+        }
+        const auto colorOf = [&](uint32_t count) noexcept {
+            return count < tableSize ? toneTable[count] : toneColor(count, options, scale);
+        };
+
+        const int w = std::min(width, target.getWidth());
+        const int h = std::min(height, target.getHeight());
+        if (auto* frame = dynamic_cast<FrameBuffer*>(&target)) {
+            Color* pixels = frame->getPixelData();
+            for (int y = 0; y < h; ++y) {
+                const uint32_t* row = counts.data() + static_cast<size_t>(y) * width;
+                Color* out = pixels + static_cast<size_t>(y) * frame->getWidth();
+                for (int x = 0; x < w; ++x) {
+                    out[x] = colorOf(row[x]);
+                }
+            }
+        }
+        else {
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    target.setPixel(x, y, colorOf(counts[static_cast<size_t>(y) * width + x]));
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,177 @@
+#include "frame_writer.h"
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include "trace.h"
+
+namespace Render {
+    AsyncFrameWriter::AsyncFrameWriter(std::shared_ptr<const IFrameEncoder> encoder, size_t queueCapacity, unsigned workerCount)
+        : encoder(std::move(encoder)), capacity(std::max<size_t>(1, queueCapacity)), ring(capacity) {
+        if (!this->encoder) {
+            this->encoder = std::make_shared<PPMEncoder>();
+        }
+
+        workerCount = std::max(1u, workerCount);
+        workers.reserve(workerCount);
+        for (unsigned i = 0; i < workerCount; ++i) {
+            workers.emplace_back(&AsyncFrameWriter::workerLoop, this);
+        }
+    }
+
+    AsyncFrameWriter::~AsyncFrameWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+
+        // Workers drain the remaining queue before exiting
+        for (auto& worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    bool AsyncFrameWriter::submit(const FrameBuffer& frame, const std::string& filename) {
+        RENDER_TRACE_SCOPE("AsyncFrameWriter::submit");
+        std::unique_lock<std::mutex> lock(mutex);
+        if (stopping) {
+            return false;
+        }
+
+        if (queued + reserved >= capacity) {
+            const auto waitStart = std::chrono::steady_clock::now();
+            notFull.wait(lock, [this] { return queued + reserved < capacity || stopping; });
+            stats.producerStalls++;
+            stats.producerStallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - waitStart).count();
+            if (stopping) {
+                return false;
+            }
+        }
+
+        // Reserve the slot, then copy the frame without holding the lock so workers and other
+        // producers are not blocked behind a frame-sized memcpy. Workers never touch reserved slots.
+        Job& job = ring[(head + queued + reserved) % capacity];
+        reserved++;
+        lock.unlock();
+
+        try {
+            // assign() reuses the slot's existing capacity once warmed up
+            job.filename.assign(filename);
+            job.width = frame.getWidth();
+            job.height = frame.getHeight();
+            job.pixels.assign(frame.getPixels().begin(), frame.getPixels().end());
+        }
+        catch (...) {
+            // Publish the slot anyway, or the frames reserved behind it would never be written
+            lock.lock();
+            const size_t published = publish(job, false);
+            lock.unlock();
+            notifyPublished(published);
+            throw;
+        }
+
+        lock.lock();
+        const size_t published = publish(job, true);
+        stats.framesSubmitted++;
+        stats.peakQueueDepth = std::max(stats.peakQueueDepth, queued);
+        lock.unlock();
+
+        notifyPublished(published);
+        return true;
+    }
+
+    size_t AsyncFrameWriter::publish(Job& job, bool copied) noexcept {
+        job.ready = true;
+        job.skipped = !copied;
+        // Producers may finish out of order; workers take slots in order, so only the filled run
+        // directly after the published ones moves over
+        size_t published = 0;
+        while (reserved > 0 && ring[(head + queued) % capacity].ready) {
+            queued++;
+            reserved--;
+            published++;
+        }
+        return published;
+    }
+
+    void AsyncFrameWriter::notifyPublished(size_t published) noexcept {
+        if (published > 1) {
+            notEmpty.notify_all();
+        }
+        else if (published == 1) {
+            notEmpty.notify_one();
+        }
+    }
+
+    void AsyncFrameWriter::flush() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return queued == 0 && reserved == 0 && inFlight == 0; });
+    }
+
+    FrameWriterStats AsyncFrameWriter::getStats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return stats;
+    }
+
+    void AsyncFrameWriter::workerLoop() {
+        RENDER_TRACE_THREAD_NAME("frame writer");
+        std::vector<uint8_t> encoded; // reused across frames
+        Job job;                      // swapped with ring slots, never freed
+
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [this] { return queued > 0 || stopping; });
+                if (queued == 0) {
+                    return; // stopping and fully drained
+                }
+                std::swap(job, ring[head]);
+                ring[head].ready = false;
+                head = (head + 1) % capacity;
+                queued--;
+                inFlight++;
+            }
+            notFull.notify_one();
+            if (job.skipped) {
+                finishJob(false, 0, false);
+                continue;
+            }
+
+            RENDER_TRACE_SCOPE("AsyncFrameWriter::writeFrame");
+            bool ok = false;
+            try {
+                encoded.clear();
+                encoder->encode(job.pixels.data(), job.width, job.height, encoded);
+
+                std::ofstream file(job.filename, std::ios::binary);
+                if (file) {
+                    file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+                    ok = file.good();
+                }
+            }
+            catch (const std::exception&) {
+                ok = false;
+            }
+
+            finishJob(ok, encoded.size(), true);
+        }
+    }
+
+    void AsyncFrameWriter::finishJob(bool written, size_t bytes, bool counted) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (written) {
+            stats.framesWritten++;
+            stats.bytesWritten += bytes;
+        }
+        else if (counted) {
+            stats.framesFailed++;
+        }
+        inFlight--;
+        if (queued == 0 && reserved == 0 && inFlight == 0) {
+            idle.notify_all();
+        }
+    }
+}
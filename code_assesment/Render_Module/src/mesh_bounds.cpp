@@ -0,0 +1,139 @@
+#include "mesh_bounds.h"
+#include <algorithm>
+#include <vector>
+#include "parallel_for.h"
+#include "trace.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_HAS_SSE2 1
+#endif
+
+namespace Render {
+    namespace {
+#ifdef RENDER_HAS_SSE2
+        static_assert(sizeof(Vertex) == 3 * sizeof(float), "Vertex positions must be packed xyz for the SIMD reductions");
+
+        // Four packed vertices are three registers: (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3).
+        // Every lane always holds the same component, so the loops need no shuffles for min/max.
+        inline void loadFour(const float* p, __m128& r0, __m128& r1, __m128& r2) noexcept {
+            r0 = _mm_loadu_ps(p);
+            r1 = _mm_loadu_ps(p + 4);
+            r2 = _mm_loadu_ps(p + 8);
+        }
+#endif
+
+        Math::BoundingBox reduceBox(std::span<const Vertex> vertices) noexcept {
+            Math::BoundingBox box;
+            size_t i = 0;
+#ifdef RENDER_HAS_SSE2
+            if (vertices.size() >= 4) {
+                const float* data = &vertices[0].getPosition().x;
+                __m128 lo0 = _mm_set1_ps(box.min.x), lo1 = lo0, lo2 = lo0;
+                __m128 hi0 = _mm_set1_ps(box.max.x), hi1 = hi0, hi2 = hi0;
+                for (; i + 4 <= vertices.size(); i += 4) {
+                    __m128 r0, r1, r2;
+                    loadFour(data + i * 3, r0, r1, r2);
+                    lo0 = _mm_min_ps(lo0, r0);
+                    lo1 = _mm_min_ps(lo1, r1);
+                    lo2 = _mm_min_ps(lo2, r2);
+                    hi0 = _mm_max_ps(hi0, r0);
+                    hi1 = _mm_max_ps(hi1, r1);
+                    hi2 = _mm_max_ps(hi2, r2);
+                }
+                alignas(16) float lo[12], hi[12];
+                _mm_store_ps(lo, lo0);
+                _mm_store_ps(lo + 4, lo1);
+                _mm_store_ps(lo + 8, lo2);
+                _mm_store_ps(hi, hi0);
+                _mm_store_ps(hi + 4, hi1);
+                _mm_store_ps(hi + 8, hi2);
+                // Lane k holds component k % 3
+                for (int k = 0; k < 12; k += 3) {
+                    box.add(Math::BoundingBox(Math::Vector3D(lo[k], lo[k + 1], lo[k + 2]), Math::Vector3D(hi[k], hi[k + 1], hi[k + 2])));
+                }
+            }
+#endif
+            for (; i < vertices.size(); ++i) {
+                box.add(vertices[i].getPosition());
+            }
+            return box;
+        }
+
+        float reduceDistanceSq(std::span<const Vertex> vertices, const Math::Vector3D& center) noexcept {
+            float result = 0.0f;
+            size_t i = 0;
+#ifdef RENDER_HAS_SSE2
+            if (vertices.size() >= 4) {
+                const float* data = &vertices[0].getPosition().x;
+                const __m128 c0 = _mm_setr_ps(center.x, center.y, center.z, center.x);
+                const __m128 c1 = _mm_setr_ps(center.y, center.z, center.x, center.y);
+                const __m128 c2 = _mm_setr_ps(center.z, center.x, center.y, center.z);
+                __m128 best = _mm_setzero_ps();
+                for (; i + 4 <= vertices.size(); i += 4) {
+                    __m128 r0, r1, r2;
+                    loadFour(data + i * 3, r0, r1, r2);
+                    r0 = _mm_sub_ps(r0, c0);
+                    r1 = _mm_sub_ps(r1, c1);
+                    r2 = _mm_sub_ps(r2, c2);
+                    const __m128 s0 = _mm_mul_ps(r0, r0);
+                    const __m128 s1 = _mm_mul_ps(r1, r1);
+                    const __m128 s2 = _mm_mul_ps(r2, r2);
+
+                    // Transpose the squares to one point per lane: dx^2, dy^2, dz^2
+                    const __m128 t = _mm_shuffle_ps(s1, s2, _MM_SHUFFLE(1, 1, 2, 2));
+                    const __m128 dx = _mm_shuffle_ps(s0, t, _MM_SHUFFLE(2, 0, 3, 0));
+                    const __m128 u = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(0, 0, 1, 1));
+                    const __m128 v = _mm_shuffle_ps(s1, s2, _MM_SHUFFLE(2, 2, 3, 3));
+                    const __m128 dy = _mm_shuffle_ps(u, v, _MM_SHUFFLE(2, 0, 2, 0));
+                    const __m128 w = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(1, 1, 2, 2));
+                    const __m128 dz = _mm_shuffle_ps(w, s2, _MM_SHUFFLE(3, 0, 2, 0));
+                    best = _mm_max_ps(best, _mm_add_ps(_mm_add_ps(dx, dy), dz));
+                }
+                alignas(16) float lanes[4];
+                _mm_store_ps(lanes, best);
+                result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+            }
+#endif
+            for (; i < vertices.size(); ++i) {
+                const Math::Vector3D d = vertices[i].getPosition() - center;
+                result = std::max(result, d.dot(d));
+            }
+            return result;
+        }
+
+        // Reduces each parallelChunks chunk, then folds the partial results in chunk order
+        template <typename T, typename Reduce, typename Combine>
+        T parallelReduce(std::span<const Vertex> vertices, T initial, Reduce&& reduce, Combine&& combine) {
+            std::vector<T> partial(parallelChunkCount(vertices.size(), BoundsChunkVertices), initial);
+            parallelChunks(vertices.size(), BoundsChunkVertices, [&](size_t chunk, size_t begin, size_t end) {
+                partial[chunk] = reduce(vertices.subspan(begin, end - begin));
+            });
+
+            T result = initial;
+            for (const auto& value : partial) {
+                result = combine(result, value);
+            }
+            return result;
+        }
+    }
+
+    MeshBounds computeMeshBounds(std::span<const Vertex> vertices) {
+        RENDER_TRACE_SCOPE("computeMeshBounds");
+        MeshBounds bounds;
+        if (vertices.empty()) return bounds;
+
+        bounds.box = parallelReduce(vertices, Math::BoundingBox(),
+            [](std::span<const Vertex> chunk) noexcept { return reduceBox(chunk); },
+            [](Math::BoundingBox a, const Math::BoundingBox& b) noexcept { a.add(b); return a; });
+
+        const Math::Vector3D center = bounds.box.center();
+        const float distanceSq = parallelReduce(vertices, 0.0f,
+            [&center](std::span<const Vertex> chunk) noexcept { return reduceDistanceSq(chunk, center); },
+            [](float a, float b) noexcept { return std::max(a, b); });
+
+        bounds.sphere.center = center;
+        bounds.sphere.radius = std::sqrt(distanceSq);
+        return bounds;
+    }
+}
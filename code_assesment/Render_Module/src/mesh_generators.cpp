@@ -0,0 +1,334 @@
+#include "mesh_generators.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include "parallel_for.h"
+#include "trace.h"
+
+namespace Render {
+    namespace MeshGenerators {
+        namespace {
+            constexpr float Pi = 3.14159265358979f;
+            constexpr size_t GenerateChunk = size_t{ 1 } << 16;
+
+            void require(bool condition, const char* message) {
+                if (!condition) throw std::invalid_argument(message);
+            }
+
+            // Calls fn(i) for every i in [0, count), split across threads in chunks of at least 'minChunk'
+            template <typename Fn>
+            void forEachParallel(size_t count, size_t minChunk, Fn&& fn) {
+                parallelChunks(count, minChunk, [&fn](size_t, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) fn(i);
+                });
+            }
+
+            template <typename EdgeType>
+            [[nodiscard]] EdgeType makeEdge(size_t a, size_t b) noexcept {
+                using Index = typename EdgeType::IndexType;
+                return EdgeType(static_cast<Index>(a), static_cast<Index>(b));
+            }
+
+            [[nodiscard]] uint64_t splitMix64(uint64_t x) noexcept {
+                x += 0x9E3779B97F4A7C15ull;
+                x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+                x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+                return x ^ (x >> 31);
+            }
+
+            // Unit icosahedron; every edge appears in exactly two faces
+            constexpr float GoldenRatio = 1.61803398875f;
+            constexpr std::array<std::array<float, 3>, 12> IcosahedronVertices{ {
+                { -1.0f, GoldenRatio, 0.0f }, { 1.0f, GoldenRatio, 0.0f }, { -1.0f, -GoldenRatio, 0.0f }, { 1.0f, -GoldenRatio, 0.0f },
+                { 0.0f, -1.0f, GoldenRatio }, { 0.0f, 1.0f, GoldenRatio }, { 0.0f, -1.0f, -GoldenRatio }, { 0.0f, 1.0f, -GoldenRatio },
+                { GoldenRatio, 0.0f, -1.0f }, { GoldenRatio, 0.0f, 1.0f }, { -GoldenRatio, 0.0f, -1.0f }, { -GoldenRatio, 0.0f, 1.0f }
+            } };
+            constexpr std::array<std::array<int, 3>, 20> IcosahedronFaces{ {
+                { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+                { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+                { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+                { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 }
+            } };
+
+            // Vertex numbering of a subdivided icosahedron with 'n' segments per original edge:
+            // the 12 corners, then n - 1 points per original edge (from its lower to its higher corner),
+            // then the (n - 1)(n - 2) / 2 interior points of each face, row by row
+            class IcosphereLayout {
+            private:
+                size_t n;
+                std::array<std::array<int, 12>, 12> edgeIds{};
+                std::array<std::array<int, 2>, 30> edgeCorners{};
+
+            public:
+                explicit IcosphereLayout(size_t segments) noexcept : n(segments) {
+                    for (auto& row : edgeIds) row.fill(-1);
+                    int next = 0;
+                    for (const auto& face : IcosahedronFaces) {
+                        for (int k = 0; k < 3; ++k) {
+                            const int a = std::min(face[k], face[(k + 1) % 3]);
+                            const int b = std::max(face[k], face[(k + 1) % 3]);
+                            if (edgeIds[a][b] < 0) {
+                                edgeIds[a][b] = edgeIds[b][a] = next;
+                                edgeCorners[next] = { a, b };
+                                ++next;
+                            }
+                        }
+                    }
+                }
+
+                [[nodiscard]] const std::array<int, 2>& corners(size_t edge) const noexcept { return edgeCorners[edge]; }
+
+                [[nodiscard]] size_t vertexCount() const noexcept { return 10 * n * n + 2; }
+                [[nodiscard]] size_t edgePointBase() const noexcept { return 12; }
+                [[nodiscard]] size_t interiorBase(size_t face) const noexcept {
+                    return 12 + 30 * (n - 1) + face * ((n - 1) * (n - 2) / 2);
+                }
+                // First interior point of lattice row i (1 <= i <= n - 2) within its face
+                [[nodiscard]] size_t interiorRowOffset(size_t i) const noexcept {
+                    return (i - 1) * (n - 1) - (i - 1) * i / 2;
+                }
+
+                // Point 's' steps from corner 'from' towards corner 'to' along their shared edge
+                [[nodiscard]] size_t edgePoint(int from, int to, size_t s) const noexcept {
+                    if (s == 0) return static_cast<size_t>(from);
+                    if (s == n) return static_cast<size_t>(to);
+                    const size_t fromLow = (from < to) ? s : n - s;
+                    return edgePointBase() + static_cast<size_t>(edgeIds[from][to]) * (n - 1) + (fromLow - 1);
+                }
+
+                // Lattice point A + (B - A) * i / n + (C - A) * j / n of 'face' (i + j <= n)
+                [[nodiscard]] size_t latticePoint(size_t face, size_t i, size_t j) const noexcept {
+                    const auto& c = IcosahedronFaces[face];
+                    if (j == 0) return edgePoint(c[0], c[1], i);
+                    if (i == 0) return edgePoint(c[0], c[2], j);
+                    if (i + j == n) return edgePoint(c[1], c[2], j);
+                    return interiorBase(face) + interiorRowOffset(i) + (j - 1);
+                }
+            };
+
+            [[nodiscard]] Math::Vector3D icosahedronCorner(int index) noexcept {
+                const auto& p = IcosahedronVertices[static_cast<size_t>(index)];
+                return Math::Vector3D(p[0], p[1], p[2]);
+            }
+        }
+
+        std::unique_ptr<WireframeObject> uvSphere(int rings, int segments, float radius, bool withFaces) {
+            RENDER_TRACE_SCOPE("MeshGenerators::uvSphere");
+            require(rings >= 2 && segments >= 3, "uvSphere: needs at least 2 rings and 3 segments");
+            const size_t R = static_cast<size_t>(rings);
+            const size_t S = static_cast<size_t>(segments);
+            const size_t vertexCount = (R - 1) * S + 2;
+            const size_t south = vertexCount - 1;
+
+            // Ring vertex (ring in [1, R - 1]); 0 and R are the poles
+            const auto ringPoint = [=](size_t ring, size_t segment) noexcept {
+                if (ring == 0) return size_t{ 0 };
+                if (ring == R) return south;
+                return 1 + (ring - 1) * S + segment % S;
+            };
+
+            auto object = std::make_unique<WireframeObject>();
+            object->assignGenerated(vertexCount, (2 * R - 1) * S, withFaces ? 2 * (R - 1) * S : 0,
+                [&](std::span<Vertex> vertices, auto edges, std::span<Face> faces) {
+                    using EdgeType = typename decltype(edges)::value_type;
+                    forEachParallel(vertexCount, GenerateChunk, [&](size_t i) {
+                        if (i == 0 || i == south) {
+                            vertices[i] = Vertex(0.0f, i == 0 ? radius : -radius, 0.0f);
+                            return;
+                        }
+                        const float theta = Pi * static_cast<float>((i - 1) / S + 1) / static_cast<float>(R);
+                        const float phi = 2.0f * Pi * static_cast<float>((i - 1) % S) / static_cast<float>(S);
+                        vertices[i] = Vertex(radius * std::sin(theta) * std::cos(phi), radius * std::cos(theta),
+                            radius * std::sin(theta) * std::sin(phi));
+                    });
+                    // Meridians pole to pole, then the closed latitude rings
+                    forEachParallel(edges.size(), GenerateChunk, [&](size_t e) {
+                        if (e < R * S) {
+                            const size_t segment = e / R, step = e % R;
+                            edges[e] = makeEdge<EdgeType>(ringPoint(step, segment), ringPoint(step + 1, segment));
+                            return;
+                        }
+                        const size_t ring = (e - R * S) / S + 1, segment = (e - R * S) % S;
+                        edges[e] = makeEdge<EdgeType>(ringPoint(ring, segment), ringPoint(ring, segment + 1));
+                    });
+                    // Triangle fans at the poles, then two triangles per quad of each inner band
+                    forEachParallel(faces.size(), GenerateChunk, [&](size_t f) {
+                        if (f < S) {
+                            faces[f] = Face(0, ringPoint(1, f + 1), ringPoint(1, f));
+                            return;
+                        }
+                        if (f < 2 * S) {
+                            faces[f] = Face(south, ringPoint(R - 1, f - S), ringPoint(R - 1, f - S + 1));
+                            return;
+                        }
+                        const size_t quad = (f - 2 * S) / 2, ring = quad / S + 1, segment = quad % S;
+                        const size_t a = ringPoint(ring, segment), b = ringPoint(ring, segment + 1);
+                        const size_t c = ringPoint(ring + 1, segment), d = ringPoint(ring + 1, segment + 1);
+                        faces[f] = (f % 2 == 0) ? Face(a, c, b) : Face(b, c, d);
+                    });
+                });
+            return object;
+        }
+
+        std::unique_ptr<WireframeObject> torus(int rings, int sides, float majorRadius, float minorRadius, bool withFaces) {
+            RENDER_TRACE_SCOPE("MeshGenerators::torus");
+            require(rings >= 3 && sides >= 3, "torus: needs at least 3 rings and 3 sides");
+            const size_t R = static_cast<size_t>(rings);
+            const size_t S = static_cast<size_t>(sides);
+            const size_t vertexCount = R * S;
+            const auto point = [=](size_t ring, size_t side) noexcept { return (ring % R) * S + side % S; };
+
+            auto object = std::make_unique<WireframeObject>();
+            object->assignGenerated(vertexCount, 2 * vertexCount, withFaces ? 2 * vertexCount : 0,
+                [&](std::span<Vertex> vertices, auto edges, std::span<Face> faces) {
+                    using EdgeType = typename decltype(edges)::value_type;
+                    forEachParallel(vertexCount, GenerateChunk, [&](size_t i) {
+                        const float u = 2.0f * Pi * static_cast<float>(i / S) / static_cast<float>(R);
+                        const float v = 2.0f * Pi * static_cast<float>(i % S) / static_cast<float>(S);
+                        const float distance = majorRadius + minorRadius * std::cos(v);
+                        vertices[i] = Vertex(distance * std::cos(u), minorRadius * std::sin(v), distance * std::sin(u));
+                    });
+                    // Around each tube section, then along the ring
+                    forEachParallel(edges.size(), GenerateChunk, [&](size_t e) {
+                        const size_t i = e % vertexCount, ring = i / S, side = i % S;
+                        edges[e] = (e < vertexCount)
+                            ? makeEdge<EdgeType>(point(ring, side), point(ring, side + 1))
+                            : makeEdge<EdgeType>(point(ring, side), point(ring + 1, side));
+                    });
+                    forEachParallel(faces.size(), GenerateChunk, [&](size_t f) {
+                        const size_t ring = (f / 2) / S, side = (f / 2) % S;
+                        const size_t a = point(ring, side), b = point(ring, side + 1);
+                        const size_t c = point(ring + 1, side), d = point(ring + 1, side + 1);
+                        faces[f] = (f % 2 == 0) ? Face(a, c, b) : Face(b, c, d);
+                    });
+                });
+            return object;
+        }
+
+        std::unique_ptr<WireframeObject> grid(int columns, int rows, float size, bool withFaces) {
+            RENDER_TRACE_SCOPE("MeshGenerators::grid");
+            require(columns >= 1 && rows >= 1, "grid: needs at least one column and one row");
+            const size_t C = static_cast<size_t>(columns);
+            const size_t R = static_cast<size_t>(rows);
+            const size_t stride = C + 1;
+            const size_t horizontal = C * (R + 1);
+            const float step = size / static_cast<float>(std::max(C, R));
+            const float left = -0.5f * step * static_cast<float>(C);
+            const float bottom = -0.5f * step * static_cast<float>(R);
+
+            auto object = std::make_unique<WireframeObject>();
+            object->assignGenerated(stride * (R + 1), horizontal + R * stride, withFaces ? 2 * C * R : 0,
+                [&](std::span<Vertex> vertices, auto edges, std::span<Face> faces) {
+                    using EdgeType = typename decltype(edges)::value_type;
+                    forEachParallel(vertices.size(), GenerateChunk, [&](size_t i) {
+                        vertices[i] = Vertex(left + step * static_cast<float>(i % stride), bottom + step * static_cast<float>(i / stride), 0.0f);
+                    });
+                    // Rows of horizontal edges, then columns of vertical ones
+                    forEachParallel(edges.size(), GenerateChunk, [&](size_t e) {
+                        if (e < horizontal) {
+                            const size_t first = (e / C) * stride + e % C;
+                            edges[e] = makeEdge<EdgeType>(first, first + 1);
+                            return;
+                        }
+                        const size_t first = e - horizontal;
+                        edges[e] = makeEdge<EdgeType>(first, first + stride);
+                    });
+                    forEachParallel(faces.size(), GenerateChunk, [&](size_t f) {
+                        const size_t cell = f / 2;
+                        const size_t a = (cell / C) * stride + cell % C;
+                        faces[f] = (f % 2 == 0) ? Face(a, a + 1, a + stride) : Face(a + 1, a + stride + 1, a + stride);
+                    });
+                });
+            return object;
+        }
+
+        std::unique_ptr<WireframeObject> pointCloud(size_t count, uint64_t seed, float halfExtent) {
+            RENDER_TRACE_SCOPE("MeshGenerators::pointCloud");
+            auto object = std::make_unique<WireframeObject>();
+            object->assignGenerated(count, 0, 0, [&](std::span<Vertex> vertices, auto, std::span<Face>) {
+                // 21 random bits per coordinate from one hash of (seed, index)
+                const float scale = 2.0f * halfExtent / static_cast<float>(1u << 21);
+                forEachParallel(count, GenerateChunk, [&](size_t i) {
+                    const uint64_t bits = splitMix64(seed ^ (static_cast<uint64_t>(i) * 0xD1B54A32D192ED03ull));
+                    const auto coordinate = [&](int shift) noexcept {
+                        return static_cast<float>((bits >> shift) & 0x1FFFFF) * scale - halfExtent;
+                    };
+                    vertices[i] = Vertex(coordinate(0), coordinate(21), coordinate(42));
+                });
+            });
+            return object;
+        }
+
+        std::unique_ptr<WireframeObject> icosphere(int subdivisions, float radius, bool withFaces) {
+            RENDER_TRACE_SCOPE("MeshGenerators::icosphere");
+            require(subdivisions >= 0 && subdivisions <= 13, "icosphere: subdivisions must be 0..13");
+            const size_t n = size_t{ 1 } << subdivisions;
+            const IcosphereLayout layout(n);
+            const float inverseN = 1.0f / static_cast<float>(n);
+            const size_t boundaryEdges = 30 * n;
+            const size_t faceEdges = 3 * n * (n - 1) / 2; // Interior edges per original face
+            // Lattice rows are the unit of parallel work for everything inside a face
+            const size_t faceRows = 20 * n;
+
+            auto object = std::make_unique<WireframeObject>();
+            object->assignGenerated(layout.vertexCount(), boundaryEdges + 20 * faceEdges, withFaces ? 20 * n * n : 0,
+                [&](std::span<Vertex> vertices, auto edges, std::span<Face> faces) {
+                    using EdgeType = typename decltype(edges)::value_type;
+                    const auto onSphere = [radius](const Math::Vector3D& p) noexcept { return Vertex(p.normalize() * radius); };
+
+                    for (int corner = 0; corner < 12; ++corner) {
+                        vertices[static_cast<size_t>(corner)] = onSphere(icosahedronCorner(corner));
+                    }
+                    forEachParallel(30 * (n - 1), GenerateChunk, [&](size_t k) {
+                        const auto& ends = layout.corners(k / (n - 1));
+                        const Math::Vector3D a = icosahedronCorner(ends[0]);
+                        const Math::Vector3D b = icosahedronCorner(ends[1]);
+                        vertices[layout.edgePointBase() + k] = onSphere(a + (b - a) * (static_cast<float>(k % (n - 1) + 1) * inverseN));
+                    });
+                    forEachParallel(boundaryEdges, GenerateChunk, [&](size_t k) {
+                        const auto& ends = layout.corners(k / n);
+                        edges[k] = makeEdge<EdgeType>(layout.edgePoint(ends[0], ends[1], k % n), layout.edgePoint(ends[0], ends[1], k % n + 1));
+                    });
+
+                    forEachParallel(faceRows, 1, [&](size_t item) {
+                        const size_t face = item / n;
+                        const size_t i = item % n;
+                        const auto& c = IcosahedronFaces[face];
+                        const Math::Vector3D a = icosahedronCorner(c[0]);
+                        const Math::Vector3D ab = (icosahedronCorner(c[1]) - a) * inverseN;
+                        const Math::Vector3D ac = (icosahedronCorner(c[2]) - a) * inverseN;
+
+                        // Interior points of row i
+                        if (i >= 1 && i + 2 <= n) {
+                            size_t out = layout.interiorBase(face) + layout.interiorRowOffset(i);
+                            for (size_t j = 1; i + j < n; ++j) {
+                                vertices[out++] = onSphere(a + ab * static_cast<float>(i) + ac * static_cast<float>(j));
+                            }
+                        }
+
+                        // Upward triangle (i, j) owns its edges towards B, towards C and the diagonal;
+                        // those on the original face's boundary were emitted above
+                        size_t out = boundaryEdges + face * faceEdges + 2 * (i * (n - 1) - i * (i - 1) / 2) +
+                            (i > 0 ? (i - 1) * n - (i - 1) * i / 2 : 0);
+                        for (size_t j = 0; i + j < n; ++j) {
+                            if (j > 0) edges[out++] = makeEdge<EdgeType>(layout.latticePoint(face, i, j), layout.latticePoint(face, i + 1, j));
+                            if (i > 0) edges[out++] = makeEdge<EdgeType>(layout.latticePoint(face, i, j), layout.latticePoint(face, i, j + 1));
+                            if (i + j + 1 < n) edges[out++] = makeEdge<EdgeType>(layout.latticePoint(face, i + 1, j), layout.latticePoint(face, i, j + 1));
+                        }
+
+                        if (faces.empty()) return;
+                        size_t faceOut = face * n * n + 2 * i * n - i * i;
+                        for (size_t j = 0; i + j < n; ++j) {
+                            faces[faceOut++] = Face(layout.latticePoint(face, i, j), layout.latticePoint(face, i + 1, j), layout.latticePoint(face, i, j + 1));
+                            if (i + j + 1 < n) {
+                                faces[faceOut++] = Face(layout.latticePoint(face, i + 1, j), layout.latticePoint(face, i + 1, j + 1),
+                                    layout.latticePoint(face, i, j + 1));
+                            }
+                        }
+                    });
+                });
+            return object;
+        }
+    }
+}
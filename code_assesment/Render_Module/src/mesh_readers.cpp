@@ -0,0 +1,671 @@
+#include "mesh_readers.h"
+#include <fstream>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include "trace.h"
+
+namespace Render {
+    void MeshBuilder::addEdgeKey(size_t a, size_t b) {
+        if (a == b) return; // Degenerate corner
+        const uint64_t low = std::min(a, b);
+        const uint64_t high = std::max(a, b);
+        if (high > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Meshes with more than 2^32 vertices are not supported");
+        }
+        edgeKeys.push_back((low << 32) | high);
+    }
+
+    void MeshBuilder::reserve(size_t vertexCount, size_t faceCount) {
+        object.reserveVertices(vertexCount);
+        object.reserveFaces(faceCount);
+        edgeKeys.reserve(faceCount * 3);
+    }
+
+    void MeshBuilder::addTriangle(size_t a, size_t b, size_t c) {
+        const size_t count = getVertexCount();
+        if (a >= count || b >= count || c >= count) {
+            throw std::runtime_error("Face references a vertex that does not exist");
+        }
+        object.addFace(Face(a, b, c));
+        addEdgeKey(a, b);
+        addEdgeKey(b, c);
+        addEdgeKey(c, a);
+    }
+
+    void MeshBuilder::addPolygon(std::span<const size_t> indices) {
+        if (indices.size() < 3) {
+            throw std::runtime_error("Face with fewer than three vertices");
+        }
+        if (indices.size() == 3) {
+            addTriangle(indices[0], indices[1], indices[2]);
+            return;
+        }
+
+        const size_t count = getVertexCount();
+        for (const size_t index : indices) {
+            if (index >= count) {
+                throw std::runtime_error("Face references a vertex that does not exist");
+            }
+        }
+
+        // Fan triangles for the depth buffer; only the outline becomes edges
+        for (size_t i = 1; i + 1 < indices.size(); ++i) {
+            object.addFace(Face(indices[0], indices[i], indices[i + 1]));
+        }
+        for (size_t i = 0; i < indices.size(); ++i) {
+            addEdgeKey(indices[i], indices[(i + 1) % indices.size()]);
+        }
+    }
+
+    void MeshBuilder::addPolyline(std::span<const size_t> indices) {
+        const size_t count = getVertexCount();
+        for (size_t i = 0; i < indices.size(); ++i) {
+            if (indices[i] >= count) {
+                throw std::runtime_error("Line references a vertex that does not exist");
+            }
+            if (i > 0) addEdgeKey(indices[i - 1], indices[i]);
+        }
+    }
+
+    void MeshBuilder::finish() {
+        RENDER_TRACE_SCOPE("MeshBuilder::finish");
+        std::sort(edgeKeys.begin(), edgeKeys.end());
+        edgeKeys.erase(std::unique(edgeKeys.begin(), edgeKeys.end()), edgeKeys.end());
+
+        object.reserveEdges(object.getEdgeCount() + edgeKeys.size(), getVertexCount());
+        for (const uint64_t key : edgeKeys) {
+            object.addEdge(Edge(static_cast<size_t>(key >> 32), static_cast<size_t>(key & 0xFFFFFFFFu)));
+        }
+        edgeKeys.clear();
+        edgeKeys.shrink_to_fit();
+    }
+
+    namespace MeshReaders {
+        namespace {
+            // Bulk reads are issued in blocks of this size
+            constexpr size_t ReadBlockBytes = size_t{ 1 } << 20;
+
+            // Elements between progress reports and cancellation checks
+            constexpr size_t ProgressInterval = 4096;
+
+            // Buffered binary input that hands out contiguous byte ranges and counts consumed bytes
+            class ByteReader {
+            private:
+                std::ifstream file;
+                std::vector<char> buffer;
+                size_t position = 0;
+                size_t end = 0;
+                uint64_t consumed = 0;
+                uint64_t size = 0;
+
+                void fill(size_t needed) {
+                    // Keep the unread tail and top the buffer up with one bulk read
+                    const size_t remaining = end - position;
+                    if (needed > buffer.size()) {
+                        buffer.resize(needed);
+                    }
+                    std::memmove(buffer.data(), buffer.data() + position, remaining);
+                    position = 0;
+                    end = remaining;
+                    file.read(buffer.data() + end, static_cast<std::streamsize>(buffer.size() - end));
+                    end += static_cast<size_t>(file.gcount());
+                }
+
+            public:
+                explicit ByteReader(const std::string& filename)
+                    : file(filename, std::ios::binary), buffer(ReadBlockBytes) {
+                    if (!file.is_open()) {
+                        throw std::runtime_error("Failed to open file: " + filename);
+                    }
+                    file.seekg(0, std::ios::end);
+                    size = static_cast<uint64_t>(file.tellg());
+                    file.seekg(0, std::ios::beg);
+                }
+
+                // Pointer to the next 'count' bytes, valid until the next call. Counts beyond the end of
+                // the file are rejected before the buffer grows, so a corrupt length cannot allocate.
+                [[nodiscard]] const char* take(size_t count) {
+                    if (count > getBytesLeft()) {
+                        throw std::runtime_error("Unexpected end of file");
+                    }
+                    if (end - position < count) {
+                        fill(count);
+                        if (end - position < count) {
+                            throw std::runtime_error("Unexpected end of file");
+                        }
+                    }
+                    const char* data = buffer.data() + position;
+                    position += count;
+                    consumed += count;
+                    return data;
+                }
+
+                [[nodiscard]] std::string readLine() {
+                    std::string line;
+                    for (;;) {
+                        if (position == end) {
+                            fill(1);
+                            if (position == end) break;
+                        }
+                        const char c = buffer[position++];
+                        consumed++;
+                        if (c == '\n') break;
+                        if (c != '\r') line.push_back(c);
+                    }
+                    return line;
+                }
+
+                [[nodiscard]] bool atEnd() {
+                    if (position == end) fill(1);
+                    return position == end;
+                }
+
+                [[nodiscard]] uint64_t getBytesRead() const noexcept {
+                    return consumed;
+                }
+
+                [[nodiscard]] uint64_t getBytesLeft() const noexcept {
+                    return size > consumed ? size - consumed : 0;
+                }
+            };
+
+            [[nodiscard]] uint64_t fileSizeOrZero(const std::string& filename) noexcept {
+                std::error_code error;
+                const auto size = std::filesystem::file_size(filename, error);
+                return error ? 0 : static_cast<uint64_t>(size);
+            }
+
+            template <typename T>
+            [[nodiscard]] T loadScalar(const char* data, bool swapBytes) noexcept {
+                char bytes[sizeof(T)];
+                std::memcpy(bytes, data, sizeof(T));
+                if (swapBytes) std::reverse(bytes, bytes + sizeof(T));
+                T value;
+                std::memcpy(&value, bytes, sizeof(T));
+                return value;
+            }
+
+            void reportProgress(LoadControl* control, uint64_t bytes, size_t vertices, size_t faces) {
+                if (control) {
+                    control->report(bytes, vertices, faces);
+                    control->throwIfCancelled();
+                }
+            }
+
+            // Exact bit pattern of a position (with -0 folded into +0) used to weld STL corners
+            struct WeldKey {
+                uint32_t x, y, z;
+                bool operator==(const WeldKey&) const noexcept = default;
+            };
+
+            struct WeldKeyHash {
+                size_t operator()(const WeldKey& key) const noexcept {
+                    uint64_t h = (static_cast<uint64_t>(key.x) << 32) ^ key.y;
+                    h ^= static_cast<uint64_t>(key.z) * 0x9E3779B97F4A7C15ull;
+                    h ^= h >> 29;
+                    h *= 0xBF58476D1CE4E5B9ull;
+                    return static_cast<size_t>(h ^ (h >> 32));
+                }
+            };
+
+            enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+            [[nodiscard]] PlyType parsePlyType(const std::string& name) {
+                if (name == "char" || name == "int8") return PlyType::Int8;
+                if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+                if (name == "short" || name == "int16") return PlyType::Int16;
+                if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+                if (name == "int" || name == "int32") return PlyType::Int32;
+                if (name == "uint" || name == "uint32") return PlyType::UInt32;
+                if (name == "float" || name == "float32") return PlyType::Float32;
+                if (name == "double" || name == "float64") return PlyType::Float64;
+                throw std::runtime_error("Unknown PLY property type: " + name);
+            }
+
+            [[nodiscard]] size_t plyTypeSize(PlyType type) noexcept {
+                switch (type) {
+                case PlyType::Int8: case PlyType::UInt8: return 1;
+                case PlyType::Int16: case PlyType::UInt16: return 2;
+                case PlyType::Float64: return 8;
+                default: return 4;
+                }
+            }
+
+            [[nodiscard]] double loadPlyValue(const char* data, PlyType type, bool swapBytes) noexcept {
+                switch (type) {
+                case PlyType::Int8: return loadScalar<int8_t>(data, false);
+                case PlyType::UInt8: return loadScalar<uint8_t>(data, false);
+                case PlyType::Int16: return loadScalar<int16_t>(data, swapBytes);
+                case PlyType::UInt16: return loadScalar<uint16_t>(data, swapBytes);
+                case PlyType::Int32: return loadScalar<int32_t>(data, swapBytes);
+                case PlyType::UInt32: return loadScalar<uint32_t>(data, swapBytes);
+                case PlyType::Float32: return loadScalar<float>(data, swapBytes);
+                default: return loadScalar<double>(data, swapBytes);
+                }
+            }
+
+            struct PlyProperty {
+                std::string name;
+                PlyType type = PlyType::Float32; // Item type for lists
+                bool isList = false;
+                PlyType countType = PlyType::UInt8;
+            };
+
+            struct PlyElement {
+                std::string name;
+                uint64_t count = 0;
+                std::vector<PlyProperty> properties;
+
+                // Record size when no property is a list, else 0
+                [[nodiscard]] size_t fixedStride() const noexcept {
+                    size_t stride = 0;
+                    for (const auto& property : properties) {
+                        if (property.isList) return 0;
+                        stride += plyTypeSize(property.type);
+                    }
+                    return stride;
+                }
+
+                // Smallest possible record: lists count only their length field
+                [[nodiscard]] size_t minimumRecordBytes() const noexcept {
+                    size_t bytes = 0;
+                    for (const auto& property : properties) {
+                        bytes += plyTypeSize(property.isList ? property.countType : property.type);
+                    }
+                    return bytes;
+                }
+            };
+
+            // Consumes one list property and returns its item count and items
+            [[nodiscard]] std::pair<size_t, const char*> takePlyList(ByteReader& reader, const PlyProperty& property, bool swapBytes) {
+                const double count = loadPlyValue(reader.take(plyTypeSize(property.countType)), property.countType, swapBytes);
+                // The length comes from the file: its bytes must fit in what is left, which also keeps
+                // items * itemSize from wrapping
+                const size_t itemSize = plyTypeSize(property.type);
+                const uint64_t maxItems = std::min<uint64_t>(reader.getBytesLeft(), std::numeric_limits<size_t>::max()) / itemSize;
+                if (!(count >= 0.0) || count > static_cast<double>(maxItems)) {
+                    throw std::runtime_error("Invalid PLY list length");
+                }
+                const size_t items = static_cast<size_t>(count);
+                return { items, reader.take(items * itemSize) };
+            }
+
+            // Records of an element this reader does not use
+            void skipPlyElement(ByteReader& reader, const PlyElement& element, bool swapBytes) {
+                const size_t stride = element.fixedStride();
+                for (uint64_t i = 0; i < element.count; ++i) {
+                    if (stride) {
+                        (void)reader.take(stride);
+                        continue;
+                    }
+                    for (const auto& property : element.properties) {
+                        if (property.isList) {
+                            (void)takePlyList(reader, property, swapBytes);
+                        }
+                        else {
+                            (void)reader.take(plyTypeSize(property.type));
+                        }
+                    }
+                }
+            }
+
+            [[nodiscard]] std::string_view trim(std::string_view text) noexcept {
+                while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+                while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+                return text;
+            }
+
+            // Next whitespace-separated token, removed from 'text'
+            [[nodiscard]] std::string_view nextToken(std::string_view& text) noexcept {
+                text = trim(text);
+                size_t length = 0;
+                while (length < text.size() && text[length] != ' ' && text[length] != '\t') ++length;
+                const std::string_view token = text.substr(0, length);
+                text.remove_prefix(length);
+                return token;
+            }
+
+            [[nodiscard]] bool parseFloat(std::string_view token, float& value) noexcept {
+                if (!token.empty() && token.front() == '+') token.remove_prefix(1);
+                const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+                return error == std::errc() && end == token.data() + token.size();
+            }
+
+            // OBJ vertex reference ("7", "7/1", "7//3", "-2/1/3") resolved to a zero-based index
+            [[nodiscard]] bool parseObjIndex(std::string_view token, size_t vertexCount, size_t& index) noexcept {
+                long long value = 0;
+                const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+                if (error != std::errc() || (end != token.data() + token.size() && *end != '/') || value == 0) {
+                    return false;
+                }
+                const long long resolved = (value > 0) ? value - 1 : static_cast<long long>(vertexCount) + value;
+                if (resolved < 0 || static_cast<unsigned long long>(resolved) >= vertexCount) {
+                    return false;
+                }
+                index = static_cast<size_t>(resolved);
+                return true;
+            }
+        }
+
+        void readBinarySTL(const std::string& filename, WireframeObject& object, LoadControl* control) {
+            RENDER_TRACE_SCOPE("MeshReaders::readBinarySTL");
+            constexpr size_t HeaderBytes = 80;
+            constexpr size_t TriangleBytes = 50; // Normal, three corners, attribute word
+
+            ByteReader reader(filename);
+            const uint64_t fileSize = fileSizeOrZero(filename);
+            if (control) control->setTotalBytes(fileSize);
+
+            // ASCII files start with "solid" and (almost always) disagree with the binary size formula
+            const auto asciiError = [&filename]() {
+                return std::runtime_error("ASCII STL is not supported: " + filename);
+            };
+            if (fileSize < HeaderBytes + 4) {
+                const size_t prefix = static_cast<size_t>(std::min<uint64_t>(fileSize, 5));
+                if (std::string_view(reader.take(prefix), prefix) == "solid") {
+                    throw asciiError();
+                }
+                throw std::runtime_error("File too small for a binary STL: " + filename);
+            }
+
+            const char* header = reader.take(HeaderBytes);
+            const bool asciiHeader = std::string_view(header, 5) == "solid";
+            const uint32_t triangleCount = loadScalar<uint32_t>(reader.take(4), std::endian::native == std::endian::big);
+            if (HeaderBytes + 4 + static_cast<uint64_t>(triangleCount) * TriangleBytes > fileSize) {
+                if (asciiHeader) throw asciiError();
+                throw std::runtime_error("Truncated STL: header declares " + std::to_string(triangleCount) + " triangles");
+            }
+
+            // A closed triangle mesh has about half as many vertices as triangles
+            MeshBuilder builder(object);
+            builder.reserve(triangleCount / 2 + 3, triangleCount);
+            std::unordered_map<WeldKey, size_t, WeldKeyHash> welded;
+            welded.reserve(triangleCount / 2 + 3);
+
+            const bool swapBytes = std::endian::native == std::endian::big;
+            const size_t trianglesPerBlock = ReadBlockBytes / TriangleBytes;
+            size_t facesRead = 0;
+
+            for (uint32_t done = 0; done < triangleCount;) {
+                const uint32_t blockCount = static_cast<uint32_t>(std::min<size_t>(triangleCount - done, trianglesPerBlock));
+                const char* block = reader.take(static_cast<size_t>(blockCount) * TriangleBytes);
+
+                for (uint32_t t = 0; t < blockCount; ++t) {
+                    const char* corners = block + static_cast<size_t>(t) * TriangleBytes + 12;
+                    size_t index[3];
+                    for (int c = 0; c < 3; ++c) {
+                        // + 0.0f folds -0 into +0 so both weld together
+                        const float x = loadScalar<float>(corners + c * 12, swapBytes) + 0.0f;
+                        const float y = loadScalar<float>(corners + c * 12 + 4, swapBytes) + 0.0f;
+                        const float z = loadScalar<float>(corners + c * 12 + 8, swapBytes) + 0.0f;
+                        const WeldKey key{ std::bit_cast<uint32_t>(x), std::bit_cast<uint32_t>(y), std::bit_cast<uint32_t>(z) };
+                        const auto [it, inserted] = welded.try_emplace(key, builder.getVertexCount());
+                        if (inserted) {
+                            builder.addVertex(Vertex(x, y, z));
+                        }
+                        index[c] = it->second;
+                    }
+
+                    // Triangles collapsed by welding draw nothing
+                    if (index[0] != index[1] && index[1] != index[2] && index[2] != index[0]) {
+                        builder.addTriangle(index[0], index[1], index[2]);
+                        facesRead++;
+                    }
+                }
+
+                done += blockCount;
+                reportProgress(control, reader.getBytesRead(), builder.getVertexCount(), facesRead);
+            }
+
+            builder.finish();
+        }
+
+        void readBinaryPLY(const std::string& filename, WireframeObject& object, LoadControl* control) {
+            RENDER_TRACE_SCOPE("MeshReaders::readBinaryPLY");
+            ByteReader reader(filename);
+            if (control) control->setTotalBytes(fileSizeOrZero(filename));
+
+            if (trim(reader.readLine()) != "ply") {
+                throw std::runtime_error("Not a PLY file: " + filename);
+            }
+
+            // Header
+            bool swapBytes = false;
+            bool formatSeen = false;
+            std::vector<PlyElement> elements;
+            for (;;) {
+                if (reader.atEnd()) {
+                    throw std::runtime_error("PLY header is missing end_header");
+                }
+                const std::string line = reader.readLine();
+                std::string_view rest = line;
+                const std::string_view keyword = nextToken(rest);
+
+                if (keyword == "end_header") break;
+
+                if (keyword == "format") {
+                    const std::string_view format = nextToken(rest);
+                    if (format == "binary_little_endian") {
+                        swapBytes = std::endian::native != std::endian::little;
+                    }
+                    else if (format == "binary_big_endian") {
+                        swapBytes = std::endian::native != std::endian::big;
+                    }
+                    else {
+                        throw std::runtime_error("Only binary PLY is supported: " + filename);
+                    }
+                    formatSeen = true;
+                }
+                else if (keyword == "element") {
+                    PlyElement element;
+                    element.name = std::string(nextToken(rest));
+                    const std::string_view count = nextToken(rest);
+                    if (std::from_chars(count.data(), count.data() + count.size(), element.count).ec != std::errc()) {
+                        throw std::runtime_error("Invalid PLY element count: " + line);
+                    }
+                    elements.push_back(std::move(element));
+                }
+                else if (keyword == "property") {
+                    if (elements.empty()) {
+                        throw std::runtime_error("PLY property before any element: " + line);
+                    }
+                    PlyProperty property;
+                    std::string_view type = nextToken(rest);
+                    if (type == "list") {
+                        property.isList = true;
+                        property.countType = parsePlyType(std::string(nextToken(rest)));
+                        type = nextToken(rest);
+                    }
+                    property.type = parsePlyType(std::string(type));
+                    property.name = std::string(nextToken(rest));
+                    elements.back().properties.push_back(std::move(property));
+                }
+                // comment, obj_info and unknown keywords are ignored
+            }
+            if (!formatSeen) {
+                throw std::runtime_error("PLY header has no format line");
+            }
+
+            // Element counts come from the header; every record takes at least minimumRecordBytes, so
+            // counts the rest of the file cannot hold are corrupt and must not size the reservations
+            uint64_t bytesLeft = reader.getBytesLeft();
+            for (const auto& element : elements) {
+                const size_t recordBytes = element.minimumRecordBytes();
+                if (element.count == 0) continue;
+                if (recordBytes == 0 || element.count > bytesLeft / recordBytes) {
+                    throw std::runtime_error("PLY element count exceeds the file size: " + element.name);
+                }
+                bytesLeft -= element.count * recordBytes;
+            }
+
+            uint64_t vertexTotal = 0;
+            uint64_t faceTotal = 0;
+            for (const auto& element : elements) {
+                if (element.name == "vertex") vertexTotal = element.count;
+                if (element.name == "face") faceTotal = element.count;
+            }
+
+            MeshBuilder builder(object);
+            builder.reserve(static_cast<size_t>(vertexTotal), static_cast<size_t>(faceTotal));
+            size_t facesRead = 0;
+            std::vector<size_t> polygon;
+
+            for (const auto& element : elements) {
+                if (element.name == "vertex") {
+                    // Offsets of x, y, z inside a fixed-size record
+                    size_t offsets[3] = { 0, 0, 0 };
+                    PlyType types[3] = { PlyType::Float32, PlyType::Float32, PlyType::Float32 };
+                    int found = 0;
+                    size_t offset = 0;
+                    for (const auto& property : element.properties) {
+                        if (property.isList) {
+                            throw std::runtime_error("PLY vertex lists are not supported");
+                        }
+                        const int axis = (property.name == "x") ? 0 : (property.name == "y") ? 1 : (property.name == "z") ? 2 : -1;
+                        if (axis >= 0) {
+                            offsets[axis] = offset;
+                            types[axis] = property.type;
+                            found |= 1 << axis;
+                        }
+                        offset += plyTypeSize(property.type);
+                    }
+                    if (found != 7) {
+                        throw std::runtime_error("PLY vertex element needs x, y and z");
+                    }
+
+                    const size_t stride = offset;
+                    const size_t recordsPerBlock = std::max<size_t>(ReadBlockBytes / stride, 1);
+                    for (uint64_t done = 0; done < element.count;) {
+                        const size_t blockCount = static_cast<size_t>(std::min<uint64_t>(element.count - done, recordsPerBlock));
+                        const char* block = reader.take(blockCount * stride);
+                        for (size_t i = 0; i < blockCount; ++i) {
+                            const char* record = block + i * stride;
+                            builder.addVertex(Vertex(
+                                static_cast<float>(loadPlyValue(record + offsets[0], types[0], swapBytes)),
+                                static_cast<float>(loadPlyValue(record + offsets[1], types[1], swapBytes)),
+                                static_cast<float>(loadPlyValue(record + offsets[2], types[2], swapBytes))));
+                        }
+                        done += blockCount;
+                        reportProgress(control, reader.getBytesRead(), builder.getVertexCount(), facesRead);
+                    }
+                }
+                else if (element.name == "face") {
+                    for (uint64_t i = 0; i < element.count; ++i) {
+                        bool hasIndices = false;
+                        for (const auto& property : element.properties) {
+                            if (!property.isList) {
+                                (void)reader.take(plyTypeSize(property.type));
+                                continue;
+                            }
+                            const auto [count, items] = takePlyList(reader, property, swapBytes);
+                            if (property.name != "vertex_indices" && property.name != "vertex_index") {
+                                continue;
+                            }
+
+                            polygon.clear();
+                            const size_t itemSize = plyTypeSize(property.type);
+                            for (size_t k = 0; k < count; ++k) {
+                                const double value = loadPlyValue(items + k * itemSize, property.type, swapBytes);
+                                if (!(value >= 0.0)) {
+                                    throw std::runtime_error("Negative PLY vertex index");
+                                }
+                                polygon.push_back(static_cast<size_t>(value));
+                            }
+                            builder.addPolygon(polygon);
+                            hasIndices = true;
+                        }
+                        if (!hasIndices) {
+                            throw std::runtime_error("PLY face element has no vertex_indices list");
+                        }
+                        if (++facesRead % ProgressInterval == 0) {
+                            reportProgress(control, reader.getBytesRead(), builder.getVertexCount(), facesRead);
+                        }
+                    }
+                }
+                else {
+                    skipPlyElement(reader, element, swapBytes);
+                }
+            }
+
+            reportProgress(control, reader.getBytesRead(), builder.getVertexCount(), facesRead);
+            builder.finish();
+        }
+
+        void readOBJ(const std::string& filename, WireframeObject& object, LoadControl* control) {
+            RENDER_TRACE_SCOPE("MeshReaders::readOBJ");
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open file: " + filename);
+            }
+
+            // One bulk read; lines are parsed in place
+            const uint64_t fileSize = fileSizeOrZero(filename);
+            if (control) control->setTotalBytes(fileSize);
+            std::string text;
+            text.resize(static_cast<size_t>(fileSize));
+            file.read(text.data(), static_cast<std::streamsize>(text.size()));
+            text.resize(static_cast<size_t>(file.gcount()));
+
+            MeshBuilder builder(object);
+            std::vector<size_t> polygon;
+            size_t facesRead = 0;
+            size_t lineNumber = 0;
+            size_t elementsSinceReport = 0;
+
+            for (size_t position = 0; position < text.size();) {
+                size_t lineEnd = text.find('\n', position);
+                if (lineEnd == std::string::npos) lineEnd = text.size();
+                std::string_view line(text.data() + position, lineEnd - position);
+                position = lineEnd + 1;
+                lineNumber++;
+
+                const std::string_view keyword = nextToken(line);
+                if (keyword == "v") {
+                    float xyz[3];
+                    for (float& value : xyz) {
+                        if (!parseFloat(nextToken(line), value)) {
+                            throw std::runtime_error("Invalid vertex at line " + std::to_string(lineNumber));
+                        }
+                    }
+                    builder.addVertex(Vertex(xyz[0], xyz[1], xyz[2]));
+                }
+                else if (keyword == "f" || keyword == "l") {
+                    polygon.clear();
+                    for (std::string_view token = nextToken(line); !token.empty(); token = nextToken(line)) {
+                        size_t index;
+                        if (!parseObjIndex(token, builder.getVertexCount(), index)) {
+                            throw std::runtime_error("Invalid vertex reference '" + std::string(token) +
+                                "' at line " + std::to_string(lineNumber));
+                        }
+                        polygon.push_back(index);
+                    }
+                    if (keyword == "f") {
+                        builder.addPolygon(polygon);
+                        facesRead++;
+                    }
+                    else {
+                        builder.addPolyline(polygon);
+                    }
+                }
+                else {
+                    continue; // Comments, normals, texture coordinates, groups, materials
+                }
+
+                if (++elementsSinceReport == ProgressInterval) {
+                    elementsSinceReport = 0;
+                    reportProgress(control, std::min<uint64_t>(position, text.size()), builder.getVertexCount(), facesRead);
+                }
+            }
+
+            reportProgress(control, text.size(), builder.getVertexCount(), facesRead);
+            builder.finish();
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "multi_line.h"
+#include <bit>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_HAS_SSE2 1
+#endif
+
+namespace Render {
+    namespace GraphicsPrimitives {
+        namespace {
+            // Structure-of-arrays walk state for up to MultiLineLanes short lines. Rows are tracked relative
+            // to 'base' so the accumulator fits 32-bit lanes: frac + k * step stays below 2^30 for
+            // k <= ShortLineMaxPixels, and base + (frac >> 24) equals the scalar DDA's row exactly.
+            struct alignas(16) LaneGroup {
+                int32_t base[MultiLineLanes];
+                int32_t frac[MultiLineLanes];
+                int32_t step[MultiLineLanes];
+                int32_t address[MultiLineLanes];
+                int32_t majorStride[MultiLineLanes];
+                int32_t minorStride[MultiLineLanes]; // Signed: the direction the row moves in
+                int32_t count[MultiLineLanes];
+                int32_t minorLimit[MultiLineLanes];
+                int lanes = 0;
+                int maxCount = 0;
+            };
+
+            void flushLanes(LaneGroup& group, Color* pixels, const Color& color, MultiLineResult& result) noexcept {
+                // Unused lanes get a zero count and never write
+                for (int i = group.lanes; i < MultiLineLanes; ++i) {
+                    group.base[i] = group.frac[i] = group.step[i] = group.address[i] = 0;
+                    group.majorStride[i] = group.minorStride[i] = group.count[i] = group.minorLimit[i] = 0;
+                }
+
+#ifdef RENDER_HAS_SSE2
+                constexpr int Registers = MultiLineLanes / 4;
+                __m128i base[Registers], frac[Registers], step[Registers], address[Registers];
+                __m128i majorStride[Registers], minorStride[Registers], count[Registers], limit[Registers], row[Registers];
+                for (int r = 0; r < Registers; ++r) {
+                    const auto load = [r](const int32_t* lanes) noexcept {
+                        return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + r * 4));
+                    };
+                    base[r] = load(group.base);
+                    frac[r] = load(group.frac);
+                    step[r] = load(group.step);
+                    address[r] = load(group.address);
+                    majorStride[r] = load(group.majorStride);
+                    minorStride[r] = load(group.minorStride);
+                    count[r] = load(group.count);
+                    limit[r] = load(group.minorLimit);
+                    row[r] = base[r]; // frac < 2^24 at the first pixel
+                }
+
+                // Per-lane pixel counts, accumulated as -1 per masked lane
+                __m128i activeCount = _mm_setzero_si128();
+                __m128i writeCount = _mm_setzero_si128();
+                const __m128i minusOne = _mm_set1_epi32(-1);
+                alignas(16) int32_t addresses[4];
+
+                for (int k = 0; k < group.maxCount; ++k) {
+                    const __m128i pixelIndex = _mm_set1_epi32(k);
+                    for (int r = 0; r < Registers; ++r) {
+                        const __m128i active = _mm_cmpgt_epi32(count[r], pixelIndex);
+                        const __m128i inside = _mm_and_si128(_mm_cmpgt_epi32(row[r], minusOne), _mm_cmpgt_epi32(limit[r], row[r]));
+                        const __m128i write = _mm_and_si128(active, inside);
+                        const unsigned writeMask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(write)));
+                        activeCount = _mm_sub_epi32(activeCount, active);
+                        writeCount = _mm_sub_epi32(writeCount, write);
+
+                        // Scatter
+                        _mm_store_si128(reinterpret_cast<__m128i*>(addresses), address[r]);
+                        if (writeMask == 0xFu) {
+                            pixels[addresses[0]] = color;
+                            pixels[addresses[1]] = color;
+                            pixels[addresses[2]] = color;
+                            pixels[addresses[3]] = color;
+                        }
+                        else {
+                            for (unsigned mask = writeMask; mask != 0; mask &= mask - 1) {
+                                pixels[addresses[std::countr_zero(mask)]] = color;
+                            }
+                        }
+
+                        // Step along the major axis; the row moves by at most one pixel
+                        frac[r] = _mm_add_epi32(frac[r], step[r]);
+                        const __m128i nextRow = _mm_add_epi32(base[r], _mm_srai_epi32(frac[r], Detail::SpanMinorShift));
+                        const __m128i moved = _mm_xor_si128(_mm_cmpeq_epi32(nextRow, row[r]), minusOne);
+                        address[r] = _mm_add_epi32(address[r], _mm_add_epi32(majorStride[r], _mm_and_si128(moved, minorStride[r])));
+                        row[r] = nextRow;
+                    }
+                }
+
+                alignas(16) int32_t totals[4];
+                _mm_store_si128(reinterpret_cast<__m128i*>(totals), _mm_sub_epi32(activeCount, writeCount));
+                result.pixelsClipped += static_cast<uint64_t>(totals[0]) + totals[1] + totals[2] + totals[3];
+                _mm_store_si128(reinterpret_cast<__m128i*>(totals), writeCount);
+                result.pixelsWritten += static_cast<uint64_t>(totals[0]) + totals[1] + totals[2] + totals[3];
+#else
+                for (int i = 0; i < group.lanes; ++i) {
+                    int32_t frac = group.frac[i];
+                    int32_t row = group.base[i];
+                    int32_t address = group.address[i];
+                    for (int k = 0; k < group.count[i]; ++k) {
+                        if (row >= 0 && row < group.minorLimit[i]) {
+                            pixels[address] = color;
+                            result.pixelsWritten++;
+                        }
+                        else {
+                            result.pixelsClipped++;
+                        }
+                        frac += group.step[i];
+                        const int32_t nextRow = group.base[i] + (frac >> Detail::SpanMinorShift);
+                        address += group.majorStride[i] + ((nextRow != row) ? group.minorStride[i] : 0);
+                        row = nextRow;
+                    }
+                }
+#endif
+                group.lanes = 0;
+                group.maxCount = 0;
+            }
+        }
+
+        MultiLineResult drawLinesSubPixel(FrameBuffer& target, std::span<const LineSegment> segments, const Color& color) noexcept {
+            const int width = target.getWidth();
+            const int height = target.getHeight();
+            Color* pixels = target.getPixelData();
+            MultiLineResult result;
+
+            // Lines are grouped by length class (1-4, 5-8, 9-16, 17-32 pixels) so lanes finish together
+            LaneGroup groups[4];
+
+            for (const auto& segment : segments) {
+                Detail::FixedSpan span;
+                if (!Detail::setupFixedSpan(segment.x0, segment.y0, segment.x1, segment.y1, width, height, span)) {
+                    continue;
+                }
+
+                const int count = span.last - span.first;
+                const int minorLimit = span.steep ? width : height;
+
+                // Long lines: scalar DDA writing directly
+                if (count > ShortLineMaxPixels) {
+                    const auto plot = [&](int x, int y) noexcept {
+                        if (x >= 0 && x < width && y >= 0 && y < height) {
+                            pixels[static_cast<size_t>(y) * width + static_cast<size_t>(x)] = color;
+                            result.pixelsWritten++;
+                        }
+                        else {
+                            result.pixelsClipped++;
+                        }
+                    };
+                    if (span.steep) {
+                        Detail::walkFixedSpan<true>(span, plot);
+                    }
+                    else {
+                        Detail::walkFixedSpan<false>(span, plot);
+                    }
+                    continue;
+                }
+
+                // Rows move at most one pixel per step, so a line starting this far outside never enters the target
+                const int32_t base = static_cast<int32_t>(span.minor >> Detail::SpanMinorShift);
+                if (base < -count || base >= minorLimit + count) {
+                    result.pixelsClipped += static_cast<uint64_t>(count);
+                    continue;
+                }
+
+                LaneGroup& group = groups[(count <= 4) ? 0 : (count <= 8) ? 1 : (count <= 16) ? 2 : 3];
+                const int lane = group.lanes++;
+                group.base[lane] = base;
+                group.frac[lane] = static_cast<int32_t>(span.minor - static_cast<int64_t>(base) * (int64_t{ 1 } << Detail::SpanMinorShift));
+                group.step[lane] = static_cast<int32_t>(span.step);
+                group.address[lane] = span.steep ? span.first * width + base : base * width + span.first;
+                group.majorStride[lane] = span.steep ? width : 1;
+                group.minorStride[lane] = (span.step < 0 ? -1 : 1) * (span.steep ? 1 : width);
+                group.count[lane] = count;
+                group.minorLimit[lane] = minorLimit;
+                group.maxCount = std::max(group.maxCount, count);
+
+                if (group.lanes == MultiLineLanes) {
+                    flushLanes(group, pixels, color, result);
+                }
+            }
+
+            for (auto& group : groups) {
+                if (group.lanes > 0) {
+                    flushLanes(group, pixels, color, result);
+                }
+            }
+            return result;
+        }
+    }
+}
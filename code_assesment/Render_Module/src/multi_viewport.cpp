@@ -0,0 +1,56 @@
+#include "multi_viewport.h"
+#include "wireframe.h"
+#include "parallel_for.h"
+#include "trace.h"
+
+namespace Render {
+    size_t MultiViewportRenderer::addViewport(Viewport viewport) {
+        Slot slot;
+        slot.renderer = std::make_unique<Renderer>(viewport.target);
+        slot.viewport = std::move(viewport);
+        slots.push_back(std::move(slot));
+        return slots.size() - 1;
+    }
+
+    void MultiViewportRenderer::drawSlot(Slot& slot, const WireframeObject& object) {
+        RENDER_TRACE_SCOPE("MultiViewportRenderer::drawViewport");
+        const Viewport& viewport = slot.viewport;
+        Renderer& renderer = *slot.renderer;
+        renderer.setLineMode(viewport.lineMode);
+        renderer.setHiddenLineRemoval(viewport.hiddenLines);
+        renderer.beginFrame();
+        renderer.clear(viewport.background);
+        renderer.drawWireframeObject(object, viewport.camera, viewport.vertexRadius, viewport.color);
+        renderer.endFrame();
+    }
+
+    void MultiViewportRenderer::draw() {
+        draw(world.get());
+    }
+
+    void MultiViewportRenderer::draw(const WireframeObject& worldObject) {
+        RENDER_TRACE_SCOPE("MultiViewportRenderer::draw");
+        if (slots.empty()) return;
+
+        // One viewport per chunk, as far as there are cores; the calling thread takes the first
+        parallelChunks(slots.size(), 1, [this, &worldObject](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                drawSlot(slots[i], worldObject);
+            }
+        });
+    }
+
+    Math::Matrix4x4 MultiViewportRenderer::frontView(float distance) noexcept {
+        return Math::Matrix4x4::createTranslation(0.0f, 0.0f, -distance);
+    }
+
+    Math::Matrix4x4 MultiViewportRenderer::sideView(float distance) noexcept {
+        // Looking down -X: rotate +X onto +Z first
+        return Math::Matrix4x4::createTranslation(0.0f, 0.0f, -distance) * Math::Matrix4x4::createRotationY(-1.57079632679f);
+    }
+
+    Math::Matrix4x4 MultiViewportRenderer::topView(float distance) noexcept {
+        // Looking down -Y: rotate +Y onto +Z first
+        return Math::Matrix4x4::createTranslation(0.0f, 0.0f, -distance) * Math::Matrix4x4::createRotationX(1.57079632679f);
+    }
+}
@@ -0,0 +1,180 @@
+#include "poster_render.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "framebuffer.h"
+#include "graphics_primitaves.h"
+#include "parallel_for.h"
+#include "wireframe.h"
+#include "trace.h"
+
+namespace Render {
+    namespace {
+        struct ScreenPosition {
+            int x, y;
+        };
+
+        // Items of band b are entries[offsets[b], offsets[b + 1])
+        struct BandBins {
+            std::vector<size_t> offsets;
+            std::vector<uint32_t> entries;
+
+            [[nodiscard]] size_t bytes() const noexcept {
+                return offsets.capacity() * sizeof(size_t) + entries.capacity() * sizeof(uint32_t);
+            }
+        };
+
+        // Counting sort by band: range(i, first, last) returns false for items that touch no band,
+        // otherwise the inclusive band range
+        template <typename Range>
+        void binByBand(size_t count, int bands, BandBins& bins, Range&& range) {
+            bins.offsets.assign(static_cast<size_t>(bands) + 1, 0);
+            int first = 0, last = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (!range(i, first, last)) continue;
+                for (int band = first; band <= last; ++band) ++bins.offsets[static_cast<size_t>(band) + 1];
+            }
+            for (size_t band = 0; band < static_cast<size_t>(bands); ++band) {
+                bins.offsets[band + 1] += bins.offsets[band];
+            }
+
+            bins.entries.resize(bins.offsets.back());
+            std::vector<size_t> cursor(bins.offsets.begin(), bins.offsets.end() - 1);
+            for (size_t i = 0; i < count; ++i) {
+                if (!range(i, first, last)) continue;
+                for (int band = first; band <= last; ++band) bins.entries[cursor[static_cast<size_t>(band)]++] = static_cast<uint32_t>(i);
+            }
+        }
+
+        // Inclusive band range of the rows [top, bottom] clipped to the image; false if none
+        [[nodiscard]] bool bandRange(int64_t top, int64_t bottom, int height, int bandHeight, int& first, int& last) noexcept {
+            if (bottom < 0 || top >= height) return false;
+            first = static_cast<int>(std::max<int64_t>(top, 0) / bandHeight);
+            last = static_cast<int>(std::min<int64_t>(bottom, height - 1) / bandHeight);
+            return true;
+        }
+    }
+
+    PosterResult PosterRenderer::render(const WireframeObject& object, const ViewTransform* view, std::ostream& out) const {
+        RENDER_TRACE_SCOPE("PosterRenderer::render");
+        const auto start = std::chrono::steady_clock::now();
+        PosterResult result;
+
+        const int width = options.width;
+        const int height = options.height;
+        const int bandHeight = std::min(options.bandHeight, height);
+        if (width <= 0 || height <= 0 || bandHeight <= 0) {
+            result.error = "Poster size and band height must be positive";
+            return result;
+        }
+        const auto& vertices = object.getVertices();
+        if (vertices.size() > std::numeric_limits<uint32_t>::max() || object.getEdgeCount() > std::numeric_limits<uint32_t>::max()) {
+            result.error = "Poster rendering supports at most 2^32 vertices and edges";
+            return result;
+        }
+
+        try {
+            result.bands = (height + bandHeight - 1) / bandHeight;
+
+            // Project once with Renderer's arithmetic so pixels match a full-frame render
+            std::vector<ScreenPosition> points(vertices.size());
+            const float halfWidth = static_cast<float>(width) / 2.0f;
+            const float halfHeight = static_cast<float>(height) / 2.0f;
+            Detail::withProjection(view, [&](auto&& toView, auto&& toPlane) {
+                for (size_t i = 0; i < vertices.size(); ++i) {
+                    const Math::Vector2D p = toPlane(toView(vertices[i].getPosition()));
+                    points[i] = ScreenPosition{ static_cast<int>((p.x + 1.0f) * halfWidth), static_cast<int>((1.0f - p.y) * halfHeight) };
+                }
+            });
+
+            const int radius = std::max(options.vertexRadius, 0);
+            BandBins vertexBins;
+            binByBand(points.size(), result.bands, vertexBins, [&](size_t i, int& first, int& last) {
+                const ScreenPosition p = points[i];
+                if (static_cast<int64_t>(p.x) + radius < 0 || static_cast<int64_t>(p.x) - radius >= width) return false;
+                return bandRange(static_cast<int64_t>(p.y) - radius, static_cast<int64_t>(p.y) + radius, height, bandHeight, first, last);
+            });
+            result.binnedVertices = vertexBins.entries.size();
+
+            object.visitEdges([&](auto edges) {
+                const size_t pointCount = points.size();
+                BandBins edgeBins;
+                binByBand(edges.size(), result.bands, edgeBins, [&](size_t i, int& first, int& last) {
+                    const size_t i1 = edges[i].getVertex1Index();
+                    const size_t i2 = edges[i].getVertex2Index();
+                    if (i1 >= pointCount || i2 >= pointCount) return false;
+                    const ScreenPosition a = points[i1];
+                    const ScreenPosition b = points[i2];
+                    // Bresenham stays within the endpoints' bounding box
+                    if (std::max(a.x, b.x) < 0 || std::min(a.x, b.x) >= width) return false;
+                    return bandRange(std::min(a.y, b.y), std::max(a.y, b.y), height, bandHeight, first, last);
+                });
+                result.binnedEdges = edgeBins.entries.size();
+
+                // One band buffer per worker; a group of bands is rendered in parallel, then written in order
+                size_t workers = parallelChunkCount(static_cast<size_t>(result.bands), 1);
+                if (options.maxWorkers > 0) {
+                    workers = std::min<size_t>(workers, options.maxWorkers);
+                }
+                std::vector<std::unique_ptr<FrameBuffer>> buffers;
+                for (size_t w = 0; w < workers; ++w) {
+                    buffers.push_back(std::make_unique<FrameBuffer>(width, bandHeight));
+                }
+                result.workingBytes = workers * static_cast<size_t>(width) * static_cast<size_t>(bandHeight) * sizeof(Color) +
+                    points.capacity() * sizeof(ScreenPosition) + vertexBins.bytes() + edgeBins.bytes();
+
+                const auto renderBand = [&](int band, FrameBuffer& target) noexcept {
+                    const int top = band * bandHeight;
+                    target.clear(options.background);
+                    for (size_t e = edgeBins.offsets[band]; e < edgeBins.offsets[band + 1]; ++e) {
+                        const auto& edge = edges[edgeBins.entries[e]];
+                        const ScreenPosition a = points[edge.getVertex1Index()];
+                        const ScreenPosition b = points[edge.getVertex2Index()];
+                        GraphicsPrimitives::drawLineInBand(target, top, a.x, a.y, b.x, b.y, options.color);
+                    }
+                    for (size_t v = vertexBins.offsets[band]; v < vertexBins.offsets[band + 1]; ++v) {
+                        const ScreenPosition p = points[vertexBins.entries[v]];
+                        GraphicsPrimitives::drawCircleInBand(target, top, p.x, p.y, radius, options.color);
+                    }
+                };
+
+                out << "P6\n" << width << " " << height << "\n255\n";
+                for (int group = 0; group < result.bands && out; group += static_cast<int>(workers)) {
+                    const size_t count = std::min(workers, static_cast<size_t>(result.bands - group));
+                    parallelChunks(count, 1, [&](size_t, size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                            renderBand(group + static_cast<int>(i), *buffers[i]);
+                        }
+                    });
+                    for (size_t i = 0; i < count; ++i) {
+                        const int rows = std::min(bandHeight, height - (group + static_cast<int>(i)) * bandHeight);
+                        out.write(reinterpret_cast<const char*>(buffers[i]->getPixels().data()),
+                            static_cast<std::streamsize>(static_cast<size_t>(width) * static_cast<size_t>(rows) * sizeof(Color)));
+                    }
+                }
+            });
+
+            if (!out) {
+                result.error = "Failed to write poster output";
+            }
+        }
+        catch (const std::exception& e) {
+            result.error = e.what();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    PosterResult PosterRenderer::render(const WireframeObject& object, const ViewTransform* view, const std::string& filename) const {
+        std::ofstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            PosterResult result;
+            result.error = "Failed to open output: " + filename;
+            return result;
+        }
+        return render(object, view, file);
+    }
+}
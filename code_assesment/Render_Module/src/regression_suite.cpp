@@ -0,0 +1,275 @@
+#include "regression_suite.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include "batch_render.h"
+#include "mesh_generators.h"
+#include "trace.h"
+
+namespace Render {
+    namespace {
+        // Scenes use the batch renderer's orbit convention
+        [[nodiscard]] ViewTransform orbitCamera(float yawDegrees, float pitchDegrees, float distance,
+            Projection projection = Projection::Orthographic, float focalLength = 1.0f) {
+            return ViewTransform{ CameraPath::fixed(yawDegrees, pitchDegrees, distance).matrixAt(0, 1, distance), projection, focalLength };
+        }
+
+        // Rotation rows of orbitCamera(yaw, pitch), worked out offline and rounded to float, so scenes
+        // that must match their golden image exactly don't depend on the C runtime's sin/cos
+        using CameraRotation = float[3][3];
+        constexpr CameraRotation Yaw30Pitch20 = { { 0.866025388f, 0.171010077f, 0.469846308f },
+            { 0.0f, 0.939692616f, -0.342020154f }, { -0.5f, 0.29619813f, 0.813797653f } };
+        constexpr CameraRotation Yaw0Pitch35 = { { 1.0f, 0.0f, 0.0f },
+            { 0.0f, 0.819152057f, -0.57357645f }, { 0.0f, 0.57357645f, 0.819152057f } };
+        constexpr CameraRotation Yaw10PitchMinus60 = { { 0.98480773f, -0.150383726f, 0.0868240893f },
+            { 0.0f, 0.5f, 0.866025388f }, { -0.173648179f, -0.852868557f, 0.492403865f } };
+        constexpr CameraRotation Yaw40Pitch30 = { { 0.766044438f, 0.321393818f, 0.556670427f },
+            { 0.0f, 0.866025388f, -0.5f }, { -0.642787635f, 0.383022219f, 0.663413942f } };
+
+        // orbitCamera built from constants only: the same matrix under every compiler and runtime
+        [[nodiscard]] ViewTransform exactCamera(const CameraRotation& rotation, float distance,
+            Projection projection = Projection::Orthographic, float focalLength = 1.0f) noexcept {
+            Math::Matrix4x4 view;
+            for (int row = 0; row < 3; ++row) {
+                for (int column = 0; column < 3; ++column) {
+                    view.set(row, column, rotation[row][column]);
+                }
+            }
+            view.set(2, 3, -distance);
+            return ViewTransform{ view, projection, focalLength };
+        }
+
+        [[nodiscard]] std::string joinPath(const std::string& directory, const std::string& file) {
+            if (directory.empty()) return file;
+            const char last = directory.back();
+            return (last == '/' || last == '\\') ? directory + file : directory + "/" + file;
+        }
+
+        [[nodiscard]] double median(std::vector<double> values) noexcept {
+            if (values.empty()) return 0.0;
+            const size_t middle = values.size() / 2;
+            std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(middle), values.end());
+            return values[middle];
+        }
+    }
+
+    ImageDifference compareImages(const FrameBuffer& actual, const FrameBuffer& expected, int channelTolerance) noexcept {
+        ImageDifference difference;
+        if (actual.getWidth() != expected.getWidth() || actual.getHeight() != expected.getHeight()) {
+            difference.sizeMismatch = true;
+            return difference;
+        }
+        const auto& a = actual.getPixels();
+        const auto& b = expected.getPixels();
+        for (size_t i = 0; i < a.size(); ++i) {
+            const int channel = std::max({ std::abs(a[i].r - b[i].r), std::abs(a[i].g - b[i].g), std::abs(a[i].b - b[i].b) });
+            difference.maxChannelDifference = std::max(difference.maxChannelDifference, channel);
+            if (channel > channelTolerance) ++difference.pixelsOverTolerance;
+        }
+        return difference;
+    }
+
+    namespace RegressionBudgets {
+        std::map<std::string, double> load(const std::string& filename) {
+            std::map<std::string, double> budgets;
+            std::ifstream file(filename);
+            std::string line;
+            while (std::getline(file, line)) {
+                const size_t comment = line.find('#');
+                if (comment != std::string::npos) line.erase(comment);
+                std::istringstream fields(line);
+                std::string scene;
+                double seconds = 0.0;
+                if (fields >> scene >> seconds && seconds > 0.0) {
+                    budgets[scene] = seconds;
+                }
+            }
+            return budgets;
+        }
+
+        bool save(const std::string& filename, const std::map<std::string, double>& budgets) {
+            std::ofstream file(filename);
+            file << "# scene median_seconds, recorded on this machine; do not commit\n";
+            for (const auto& [scene, seconds] : budgets) {
+                file << scene << ' ' << seconds << '\n';
+            }
+            return static_cast<bool>(file);
+        }
+    }
+
+    RegressionSuite RegressionSuite::withDefaultScenes() {
+        RegressionSuite suite;
+
+        RegressionScene tetrahedron;
+        tetrahedron.name = "tetrahedron_aliased";
+        tetrahedron.makeMesh = [] { return WireframeObject::createTetrahedron(1.5f); };
+        tetrahedron.camera = exactCamera(Yaw30Pitch20, 5.0f);
+        tetrahedron.vertexRadius = 3;
+        suite.addScene(tetrahedron);
+
+        // Blended and fixed-point paths, and the runtime sin/cos of orbitCamera, may round differently
+        // between compilers
+        RegressionScene icosphere;
+        icosphere.name = "icosphere_antialiased";
+        icosphere.makeMesh = [] { return MeshGenerators::icosphere(4, 0.9f); };
+        icosphere.camera = orbitCamera(15.0f, 25.0f, 5.0f);
+        icosphere.lineMode = LineMode::AntiAliased;
+        icosphere.channelTolerance = 2;
+        icosphere.pixelTolerance = 0.001;
+        suite.addScene(icosphere);
+
+        RegressionScene grid;
+        grid.name = "grid_subpixel";
+        grid.makeMesh = [] { return MeshGenerators::grid(60, 60, 1.6f); };
+        grid.camera = orbitCamera(20.0f, -60.0f, 5.0f);
+        grid.lineMode = LineMode::SubPixel;
+        grid.vertexRadius = 0;
+        grid.channelTolerance = 2;
+        grid.pixelTolerance = 0.001;
+        suite.addScene(grid);
+
+        RegressionScene hidden;
+        hidden.name = "icosphere_hidden_lines";
+        hidden.makeMesh = [] { return MeshGenerators::icosphere(3, 0.9f, true); };
+        hidden.camera = exactCamera(Yaw0Pitch35, 5.0f);
+        hidden.hiddenLines = true;
+        hidden.vertexRadius = 2;
+        suite.addScene(hidden);
+
+        RegressionScene perspective;
+        perspective.name = "grid_perspective";
+        perspective.makeMesh = [] { return MeshGenerators::grid(24, 24, 2.0f); };
+        perspective.camera = exactCamera(Yaw10PitchMinus60, 2.5f, Projection::Perspective, 1.5f);
+        perspective.vertexRadius = 0;
+        suite.addScene(perspective);
+
+        // Throughput scene for the edge hot path: ~2M edges
+        RegressionScene large;
+        large.name = "icosphere_large";
+        large.makeMesh = [] { return MeshGenerators::icosphere(8, 0.9f); };
+        large.camera = exactCamera(Yaw40Pitch30, 5.0f);
+        large.vertexRadius = 0;
+        suite.addScene(large);
+
+        return suite;
+    }
+
+    std::vector<RegressionResult> RegressionSuite::run(const RegressionOptions& options) const {
+        RENDER_TRACE_SCOPE("RegressionSuite::run");
+        std::map<std::string, double> budgets;
+        if (!options.budgetFile.empty()) {
+            budgets = RegressionBudgets::load(options.budgetFile);
+        }
+        std::vector<RegressionResult> results;
+
+        for (const auto& scene : scenes) {
+            RegressionResult result;
+            result.scene = scene.name;
+            try {
+                const std::unique_ptr<WireframeObject> mesh = scene.makeMesh();
+                auto frame = std::make_shared<FrameBuffer>(scene.width, scene.height);
+                Renderer renderer(frame);
+                renderer.setLineMode(scene.lineMode);
+                renderer.setHiddenLineRemoval(scene.hiddenLines);
+                const auto stats = options.collectStats ? std::make_shared<RenderStats>() : nullptr;
+
+                const auto drawFrame = [&] {
+                    renderer.beginFrame();
+                    renderer.clear(scene.background);
+                    renderer.drawWireframeObject(*mesh, scene.camera, scene.vertexRadius, scene.color);
+                    renderer.endFrame();
+                };
+
+                // Every frame is identical; the untimed first one warms caches and the frame arena.
+                // Short scenes repeat within a sample so timer resolution and jitter stay small.
+                drawFrame();
+                renderer.setStats(stats); // From here on, so the warm-up frame is not recorded
+                std::vector<double> times;
+                for (int run = 0; run < std::max(options.timingRuns, 1); ++run) {
+                    const auto start = std::chrono::steady_clock::now();
+                    int frames = 0;
+                    double elapsed = 0.0;
+                    do {
+                        drawFrame();
+                        ++frames;
+                        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    } while (elapsed < options.minSampleSeconds);
+                    times.push_back(elapsed / frames);
+                }
+                result.medianSeconds = median(times);
+                if (stats) {
+                    result.statsReport = stats->formatReport();
+                }
+
+                const std::string goldenFile = joinPath(options.goldenDirectory, scene.name + ".ppm");
+                const std::string actualFile = joinPath(options.goldenDirectory, scene.name + ".actual.ppm");
+                if (options.updateImages) {
+                    std::remove(actualFile.c_str());
+                    result.imagePassed = frame->saveToPPM(goldenFile);
+                    if (!result.imagePassed) {
+                        result.error = "Failed to write " + goldenFile;
+                    }
+                }
+                else if (const auto golden = FrameBuffer::loadFromPPM(goldenFile)) {
+                    result.difference = compareImages(*frame, *golden, scene.channelTolerance);
+                    const double allowed = scene.pixelTolerance * static_cast<double>(frame->getPixels().size());
+                    result.imagePassed = !result.difference.sizeMismatch &&
+                        static_cast<double>(result.difference.pixelsOverTolerance) <= allowed;
+                }
+                else {
+                    result.error = "Missing golden image " + goldenFile;
+                }
+                if (!result.imagePassed && !options.updateImages) {
+                    // Kept next to the golden image for inspection
+                    frame->saveToPPM(actualFile);
+                }
+
+                const auto budget = budgets.find(scene.name);
+                if (options.updateBudgets) {
+                    budgets[scene.name] = result.medianSeconds;
+                    result.budgetSeconds = result.medianSeconds;
+                    result.timingPassed = true;
+                }
+                else if (budget != budgets.end()) {
+                    result.budgetSeconds = budget->second;
+                    result.timingChecked = true;
+                    result.timingPassed = result.medianSeconds <= budget->second * options.budgetTolerance;
+                }
+                else {
+                    result.timingPassed = true;
+                }
+            }
+            catch (const std::exception& e) {
+                result.error = e.what();
+            }
+            results.push_back(std::move(result));
+        }
+
+        if (options.updateBudgets && (options.budgetFile.empty() || !RegressionBudgets::save(options.budgetFile, budgets))) {
+            for (auto& result : results) {
+                if (result.error.empty()) result.error = "Failed to write budget file '" + options.budgetFile + "'";
+            }
+        }
+        return results;
+    }
+
+    void RegressionSuite::writeReport(std::ostream& out, const std::vector<RegressionResult>& results) {
+        out << "scene\timage\tmax_diff\tpixels_over\ttiming\tmedian_ms\tbudget_ms\terror\n";
+        size_t failed = 0;
+        for (const auto& result : results) {
+            if (!result.passed()) ++failed;
+            out << result.scene << '\t'
+                << (result.imagePassed ? "ok" : "FAIL") << '\t'
+                << result.difference.maxChannelDifference << '\t'
+                << result.difference.pixelsOverTolerance << '\t'
+                << (!result.timingChecked ? (result.timingPassed ? "-" : "FAIL") : (result.timingPassed ? "ok" : "FAIL")) << '\t'
+                << result.medianSeconds * 1000.0 << '\t'
+                << result.budgetSeconds * 1000.0 << '\t'
+                << result.error << '\n';
+        }
+        out << (failed == 0 ? "PASS" : "FAIL") << '\t' << results.size() - failed << '/' << results.size() << " scenes passed\n";
+    }
+}
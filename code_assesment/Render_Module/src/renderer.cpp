@@ -3,21 +3,320 @@
 
 namespace Render {
     void Renderer::drawWireframeObject(const WireframeObject& object, int vertexRadius, const Color& color) noexcept {
+        RENDER_TRACE_SCOPE("Renderer::drawWireframeObject");
+        if (stats) {
+            CountingRenderTarget counted(*renderTarget, stats->counters());
+            drawWireframeObjectTo(counted, object, nullptr, vertexRadius, color);
+        }
+        else {
+            drawWireframeObjectTo(*renderTarget, object, nullptr, vertexRadius, color);
+        }
+    }
+
+    void Renderer::drawWireframeObject(const WireframeObject& object, const ViewTransform& view, int vertexRadius,
+        const Color& color) noexcept {
+        RENDER_TRACE_SCOPE("Renderer::drawWireframeObject");
+        if (stats) {
+            CountingRenderTarget counted(*renderTarget, stats->counters());
+            drawWireframeObjectTo(counted, object, &view, vertexRadius, color);
+        }
+        else {
+            drawWireframeObjectTo(*renderTarget, object, &view, vertexRadius, color);
+        }
+    }
+
+    void Renderer::drawPointDensity(const WireframeObject& object, const DensitySplatOptions& options) noexcept {
+        drawPointDensityTo(object, nullptr, options);
+    }
+
+    void Renderer::drawPointDensity(const WireframeObject& object, const ViewTransform& view, const DensitySplatOptions& options) noexcept {
+        drawPointDensityTo(object, &view, options);
+    }
+
+    void Renderer::drawPointDensityTo(const WireframeObject& object, const ViewTransform* view, const DensitySplatOptions& options) noexcept {
+        RENDER_TRACE_SCOPE("Renderer::drawPointDensity");
+        try {
+            if (!densitySplatter) {
+                densitySplatter = std::make_unique<DensitySplatter>();
+            }
+            {
+                ScopedStageTimer timer(stats.get(), RenderStage::Projection);
+                densitySplatter->accumulate(object.getVertices(), renderTarget->getWidth(), renderTarget->getHeight(), view);
+            }
+            ScopedStageTimer timer(stats.get(), RenderStage::Rasterization);
+            densitySplatter->resolve(*renderTarget, options);
+        }
+        catch (const std::exception&) {
+            return; // Out of memory for the count buffers; the frame keeps its contents
+        }
+        if (stats) {
+            stats->counters().verticesDrawn += object.getVertices().size();
+        }
+    }
+
+    template <typename ToView, typename ToPlane>
+    void Renderer::projectPoints(std::span<const Vertex> vertices, ScreenPoint* out, float halfWidth, float halfHeight,
+        ToView&& toView, ToPlane&& toPlane) noexcept {
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            const Math::Vector3D pos = toView(vertices[i].getPosition());
+            const Math::Vector2D p = toPlane(pos);
+            const float screenX = (p.x + 1.0f) * halfWidth;
+            const float screenY = (1.0f - p.y) * halfHeight;
+            out[i] = ScreenPoint{
+                static_cast<int>(screenX),
+                static_cast<int>(screenY),
+                -pos.z, // The camera looks down -Z
+                GraphicsPrimitives::toFixed(screenX),
+                GraphicsPrimitives::toFixed(screenY),
+                screenX,
+                screenY
+            };
+        }
+    }
+
+    bool Renderer::projectVertices(const IRenderTarget& target, std::span<const Vertex> vertices, const ViewTransform* view,
+        std::pmr::vector<ScreenPoint>& screenPoints) noexcept {
+        RENDER_TRACE_SCOPE("Renderer::project");
+        ScopedStageTimer timer(stats.get(), RenderStage::Projection);
+        try {
+            if (!frameOpen) {
+                frameArena.reset(); // Each call is its own frame
+            }
+            screenPoints.resize(vertices.size());
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+
+        // Viewport constants hoisted out of the loop; same arithmetic as worldToScreen
+        const float halfWidth = static_cast<float>(target.getWidth()) / 2.0f;
+        const float halfHeight = static_cast<float>(target.getHeight()) / 2.0f;
+        ScreenPoint* out = screenPoints.data();
+
+        Detail::withProjection(view, [&](auto&& toView, auto&& toPlane) {
+            projectPoints(vertices, out, halfWidth, halfHeight, toView, toPlane);
+        });
+        return true;
+    }
+
+    template <typename Index>
+    void Renderer::rasterizeEdges(IRenderTarget& target, std::span<const ScreenPoint> screenPoints, std::span<const BasicEdge<Index>> edges,
+        const Color& color, bool indicesValidated, FrameCounters& counters) noexcept {
+        using Segment = GraphicsPrimitives::LineSegment;
+        Segment block[EdgeBlockSize];
+        const size_t pointCount = screenPoints.size();
+        const bool antiAliased = lineMode == LineMode::AntiAliased;
+        const bool subPixel = lineMode == LineMode::SubPixel;
+        const auto makeSegment = [subPixel](const ScreenPoint& a, const ScreenPoint& b) noexcept {
+            return subPixel ? Segment{ a.subX, a.subY, b.subX, b.subY } : Segment{ a.x, a.y, b.x, b.y };
+        };
+
+        // Sub-pixel lines into a plain frame buffer go through the multi-line kernel, which writes
+        // pixels directly and reports its own counts when the target is wrapped for stats
+        FrameBuffer* directTarget = nullptr;
+        FrameCounters* pixelCounters = nullptr;
+        if (subPixel) {
+            if (auto* counted = dynamic_cast<CountingRenderTarget*>(&target)) {
+                directTarget = dynamic_cast<FrameBuffer*>(&counted->getInner());
+                pixelCounters = &counted->getCounters();
+            }
+            else {
+                directTarget = dynamic_cast<FrameBuffer*>(&target);
+            }
+        }
+
+        for (size_t base = 0; base < edges.size(); base += EdgeBlockSize) {
+            const size_t blockEnd = std::min(edges.size(), base + EdgeBlockSize);
+            size_t count = 0;
+
+            // Gather: resolve indices for the whole block before touching the target
+            if (indicesValidated) {
+                for (size_t i = base; i < blockEnd; ++i) {
+                    const ScreenPoint& a = screenPoints[edges[i].getVertex1Index()];
+                    const ScreenPoint& b = screenPoints[edges[i].getVertex2Index()];
+                    block[count++] = makeSegment(a, b);
+                }
+            }
+            else {
+                for (size_t i = base; i < blockEnd; ++i) {
+                    const size_t i1 = edges[i].getVertex1Index();
+                    const size_t i2 = edges[i].getVertex2Index();
+                    if (i1 < pointCount && i2 < pointCount) {
+                        block[count++] = makeSegment(screenPoints[i1], screenPoints[i2]);
+                    }
+                }
+                counters.edgesInvalid += (blockEnd - base) - count;
+            }
+
+            // Rasterize
+            if (directTarget) {
+                const auto written = GraphicsPrimitives::drawLinesSubPixel(*directTarget, std::span<const Segment>(block, count), color);
+                if (pixelCounters) {
+                    pixelCounters->pixelsWritten += written.pixelsWritten;
+                    pixelCounters->pixelsClipped += written.pixelsClipped;
+                }
+            }
+            else if (subPixel) {
+                for (size_t i = 0; i < count; ++i) {
+                    GraphicsPrimitives::drawLineSubPixel(target, block[i].x0, block[i].y0, block[i].x1, block[i].y1, color);
+                }
+            }
+            else if (antiAliased) {
+                for (size_t i = 0; i < count; ++i) {
+                    GraphicsPrimitives::drawLineAA(target, block[i].x0, block[i].y0, block[i].x1, block[i].y1, color);
+                }
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) {
+                    GraphicsPrimitives::drawLine(target, block[i].x0, block[i].y0, block[i].x1, block[i].y1, color);
+                }
+            }
+            counters.edgesDrawn += count;
+        }
+    }
+
+    void Renderer::recordCounters(const FrameCounters& counters) noexcept {
+        if (stats) {
+            auto& total = stats->counters();
+            total.edgesDrawn += counters.edgesDrawn;
+            total.edgesCulled += counters.edgesCulled;
+            total.edgesInvalid += counters.edgesInvalid;
+            total.verticesDrawn += counters.verticesDrawn;
+        }
+    }
+
+    template <typename Index>
+    void Renderer::drawEdgeBatch(std::span<const Vertex> vertices, std::span<const BasicEdge<Index>> edges, const Color& color,
+        bool indicesValidated) noexcept {
+        RENDER_TRACE_SCOPE("Renderer::drawEdgeBatch");
+        FrameCounters counters;
+
+        std::pmr::vector<ScreenPoint> screenPoints(&frameArena);
+        if (!projectVertices(*renderTarget, vertices, nullptr, screenPoints)) {
+            return;
+        }
+
+        {
+            ScopedStageTimer timer(stats.get(), RenderStage::Rasterization);
+            RENDER_TRACE_SCOPE("Renderer::rasterize");
+            if (stats) {
+                CountingRenderTarget counted(*renderTarget, stats->counters());
+                rasterizeEdges(counted, screenPoints, edges, color, indicesValidated, counters);
+            }
+            else {
+                rasterizeEdges(*renderTarget, screenPoints, edges, color, indicesValidated, counters);
+            }
+        }
+        recordCounters(counters);
+    }
+
+    void Renderer::drawWireframeObjectTo(IRenderTarget& target, const WireframeObject& object, const ViewTransform* view,
+        int vertexRadius, const Color& color) noexcept {
+        FrameCounters counters;
+
+        // Project every vertex once; edges then only look up screen positions
+        std::pmr::vector<ScreenPoint> screenPoints(&frameArena);
+        if (!projectVertices(target, object.getVertices(), view, screenPoints)) {
+            return;
+        }
+
+        {
+            ScopedStageTimer timer(stats.get(), RenderStage::Rasterization);
+            RENDER_TRACE_SCOPE("Renderer::rasterize");
+
+            if (!(hiddenLineRemoval && !object.getFaces().empty() &&
+                drawHiddenLineObject(target, object, screenPoints, vertexRadius, color, counters))) {
+                object.visitEdges([&](auto edges) {
+                    rasterizeEdges(target, std::span<const ScreenPoint>(screenPoints), edges, color, object.hasValidEdgeIndices(), counters);
+                });
+
+                // Draw all vertices
+                for (const auto& point : screenPoints) {
+                    GraphicsPrimitives::drawCircle(target, point.x, point.y, vertexRadius, color);
+                }
+                counters.verticesDrawn += screenPoints.size();
+            }
+        }
+
+        recordCounters(counters);
+    }
+
+    bool Renderer::drawHiddenLineObject(IRenderTarget& target, const WireframeObject& object,
+        std::span<const ScreenPoint> screenPoints, int vertexRadius, const Color& color, FrameCounters& counters) noexcept {
+        const int width = target.getWidth();
+        const int height = target.getHeight();
+
+        try {
+            if (!depthBuffer || depthBuffer->getWidth() != width || depthBuffer->getHeight() != height) {
+                depthBuffer = std::make_unique<DepthBuffer>(width, height);
+            }
+            else {
+                depthBuffer->clear();
+            }
+        }
+        catch (const std::exception&) {
+            return false; // Fall back to drawing every edge
+        }
+
         const auto& vertices = object.getVertices();
-        const auto& edges = object.getEdges();
 
-        // Draw all edges
-        for (const auto& edge : edges) {
-            if (edge.getVertex1Index() < vertices.size() && edge.getVertex2Index() < vertices.size()) {
-                const auto& v1 = vertices[edge.getVertex1Index()].getPosition();
-                const auto& v2 = vertices[edge.getVertex2Index()].getPosition();
-                drawEdge(v1, v2, color);
+        // Rasterize occluders from the positions already projected for the edges
+        for (const auto& face : object.getFaces()) {
+            if (face.getVertex1Index() >= vertices.size() || face.getVertex2Index() >= vertices.size() ||
+                face.getVertex3Index() >= vertices.size()) {
+                continue;
             }
+            const ScreenPoint& s0 = screenPoints[face.getVertex1Index()];
+            const ScreenPoint& s1 = screenPoints[face.getVertex2Index()];
+            const ScreenPoint& s2 = screenPoints[face.getVertex3Index()];
+            depthBuffer->rasterizeTriangle(s0.screenX, s0.screenY, s0.depth, s1.screenX, s1.screenY, s1.depth,
+                s2.screenX, s2.screenY, s2.depth);
         }
+        depthBuffer->buildPyramid();
+
+        // Depth-tested edges; whole edges behind the pyramid are rejected without rasterizing
+        object.visitEdges([&](auto edges) {
+            for (const auto& edge : edges) {
+                if (edge.getVertex1Index() >= vertices.size() || edge.getVertex2Index() >= vertices.size()) {
+                    counters.edgesInvalid++;
+                    continue;
+                }
+                const auto& a = screenPoints[edge.getVertex1Index()];
+                const auto& b = screenPoints[edge.getVertex2Index()];
 
-        // Draw all vertices
-        for (const auto& vertex : vertices) {
-            drawVertex(vertex.getPosition(), vertexRadius, color);
+                if (depthBuffer->isRectOccluded(std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y),
+                    std::min(a.depth, b.depth) - depthBias)) {
+                    counters.edgesCulled++;
+                    continue;
+                }
+
+                if (lineMode == LineMode::SubPixel) {
+                    GraphicsPrimitives::drawLineSubPixelDepthTested(target, *depthBuffer, a.subX, a.subY, a.depth,
+                        b.subX, b.subY, b.depth, color, depthBias);
+                }
+                else if (lineMode == LineMode::AntiAliased) {
+                    GraphicsPrimitives::drawLineAADepthTested(target, *depthBuffer, a.x, a.y, a.depth, b.x, b.y, b.depth, color, depthBias);
+                }
+                else {
+                    GraphicsPrimitives::drawLineDepthTested(target, *depthBuffer, a.x, a.y, a.depth, b.x, b.y, b.depth, color, depthBias);
+                }
+                counters.edgesDrawn++;
+            }
+        });
+
+        // Only draw vertices whose centre is visible
+        for (const auto& point : screenPoints) {
+            if (depthBuffer->isVisible(point.x, point.y, point.depth, depthBias)) {
+                GraphicsPrimitives::drawCircle(target, point.x, point.y, vertexRadius, color);
+                counters.verticesDrawn++;
+            }
         }
+
+        return true;
     }
+
+    // Edge storage widths used by WireframeObject
+    template void Renderer::drawEdgeBatch<uint16_t>(std::span<const Vertex>, std::span<const Edge16>, const Color&, bool) noexcept;
+    template void Renderer::drawEdgeBatch<uint32_t>(std::span<const Vertex>, std::span<const Edge32>, const Color&, bool) noexcept;
+    template void Renderer::drawEdgeBatch<WideEdgeIndex>(std::span<const Vertex>, std::span<const EdgeWide>, const Color&, bool) noexcept;
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+#include "target_benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "graphics_primitaves.h"
+
+namespace Render {
+    namespace {
+        // Small deterministic generator so runs are repeatable across platforms
+        struct Lcg {
+            uint32_t state;
+
+            [[nodiscard]] int next(int bound) noexcept {
+                state = state * 1664525u + 1013904223u;
+                return bound > 0 ? static_cast<int>((state >> 8) % static_cast<uint32_t>(bound)) : 0;
+            }
+        };
+
+        template <typename Fn>
+        [[nodiscard]] double timed(Fn&& fn) noexcept {
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        [[nodiscard]] uint64_t circlePixelCount(int radius) noexcept {
+            uint64_t count = 0;
+            for (int y = -radius; y <= radius; ++y) {
+                for (int x = -radius; x <= radius; ++x) {
+                    if (x * x + y * y <= radius * radius) ++count;
+                }
+            }
+            return count;
+        }
+    }
+
+    TargetBenchmarkResult benchmarkTarget(IRenderTarget& target, const TargetBenchmarkOptions& options) noexcept {
+        TargetBenchmarkResult result;
+        const int width = target.getWidth();
+        const int height = target.getHeight();
+        if (width <= 0 || height <= 0) return result;
+
+        const Color color = Color::White();
+        target.clear();
+
+        // Steep lines run most of the target's height with a small horizontal drift
+        Lcg rng{ options.seed };
+        result.steepLineSeconds = timed([&] {
+            for (int i = 0; i < options.lineCount; ++i) {
+                const int x0 = rng.next(width);
+                const int y0 = rng.next(height / 4 + 1);
+                const int y1 = height - 1 - rng.next(height / 4 + 1);
+                const int x1 = std::clamp(x0 + rng.next(65) - 32, 0, width - 1);
+                GraphicsPrimitives::drawLine(target, x0, y0, x1, y1, color);
+                result.steepLinePixels += static_cast<uint64_t>(std::max(std::abs(x1 - x0), std::abs(y1 - y0))) + 1;
+            }
+        });
+
+        rng = Lcg{ options.seed };
+        result.shallowLineSeconds = timed([&] {
+            for (int i = 0; i < options.lineCount; ++i) {
+                const int y0 = rng.next(height);
+                const int x0 = rng.next(width / 4 + 1);
+                const int x1 = width - 1 - rng.next(width / 4 + 1);
+                const int y1 = std::clamp(y0 + rng.next(65) - 32, 0, height - 1);
+                GraphicsPrimitives::drawLine(target, x0, y0, x1, y1, color);
+                result.shallowLinePixels += static_cast<uint64_t>(std::max(std::abs(x1 - x0), std::abs(y1 - y0))) + 1;
+            }
+        });
+
+        // Counted up front (including clipped pixels) so the count stays out of the timing
+        const int minRadius = std::max(options.minRadius, 0);
+        const int maxRadius = std::max(options.maxRadius, minRadius);
+        rng = Lcg{ options.seed };
+        for (int i = 0; i < options.circleCount; ++i) {
+            (void)rng.next(width);
+            (void)rng.next(height);
+            result.circlePixels += circlePixelCount(minRadius + rng.next(maxRadius - minRadius + 1));
+        }
+        rng = Lcg{ options.seed };
+        result.circleSeconds = timed([&] {
+            for (int i = 0; i < options.circleCount; ++i) {
+                const int x = rng.next(width);
+                const int y = rng.next(height);
+                const int radius = minRadius + rng.next(maxRadius - minRadius + 1);
+                GraphicsPrimitives::drawCircle(target, x, y, radius, color);
+            }
+        });
+        return result;
+    }
+
+    void writeTargetBenchmark(std::ostream& out, const std::string& name, const TargetBenchmarkResult& result) {
+        out << name << '\t'
+            << result.steepLinePixelsPerSecond() / 1e6 << '\t'
+            << result.shallowLinePixelsPerSecond() / 1e6 << '\t'
+            << result.circlePixelsPerSecond() / 1e6 << '\n';
+    }
+}
@@ -0,0 +1,152 @@
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+
+namespace Render {
+    namespace Trace {
+        namespace {
+            struct Event {
+                const char* name;
+                uint64_t startNs;
+                uint64_t endNs;
+            };
+
+            // Single-writer ring buffer owned by one thread; read only after tracing stops
+            struct ThreadBuffer {
+                uint32_t threadId;
+                std::string threadName;
+                std::vector<Event> events;
+                size_t next = 0;
+                bool wrapped = false;
+                uint64_t sessionId = 0;
+            };
+
+            std::atomic<bool> enabled{ false };
+            std::atomic<uint64_t> currentSession{ 0 };
+            std::atomic<size_t> bufferCapacity{ 65536 };
+            const auto epoch = std::chrono::steady_clock::now();
+
+            std::mutex registryMutex;
+            std::vector<std::shared_ptr<ThreadBuffer>> registry; // keeps buffers alive past thread exit
+            uint32_t nextThreadId = 1;
+
+            ThreadBuffer& localBuffer() {
+                thread_local std::shared_ptr<ThreadBuffer> buffer;
+                if (!buffer) {
+                    buffer = std::make_shared<ThreadBuffer>();
+                    std::lock_guard<std::mutex> lock(registryMutex);
+                    buffer->threadId = nextThreadId++;
+                    registry.push_back(buffer);
+                }
+
+                // Lazily reset the ring when a new session starts
+                const uint64_t session = currentSession.load(std::memory_order_acquire);
+                if (buffer->sessionId != session) {
+                    buffer->sessionId = session;
+                    buffer->events.assign(bufferCapacity.load(std::memory_order_relaxed), Event{});
+                    buffer->next = 0;
+                    buffer->wrapped = false;
+                }
+                return *buffer;
+            }
+
+            void writeEscaped(std::ofstream& out, const char* text) {
+                for (const char* c = text; *c; ++c) {
+                    if (*c == '"' || *c == '\\') out << '\\';
+                    out << *c;
+                }
+            }
+        }
+
+        void start(size_t eventsPerThread) {
+            bufferCapacity.store(eventsPerThread > 0 ? eventsPerThread : 1, std::memory_order_relaxed);
+            currentSession.fetch_add(1, std::memory_order_acq_rel);
+            enabled.store(true, std::memory_order_release);
+        }
+
+        void stop() noexcept {
+            enabled.store(false, std::memory_order_release);
+        }
+
+        bool isEnabled() noexcept {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        uint64_t nowNs() noexcept {
+            // Never returns 0 so ScopedEvent can use it as "not recording"
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epoch).count()) + 1;
+        }
+
+        void setThreadName(const char* name) {
+            ThreadBuffer& buffer = localBuffer();
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffer.threadName = name;
+        }
+
+        void recordEvent(const char* name, uint64_t startNs, uint64_t endNs) noexcept {
+            if (!isEnabled()) return;
+            try {
+                ThreadBuffer& buffer = localBuffer();
+                buffer.events[buffer.next] = Event{ name, startNs, endNs };
+                if (++buffer.next == buffer.events.size()) {
+                    buffer.next = 0;
+                    buffer.wrapped = true;
+                }
+            }
+            catch (const std::exception&) {
+                // Dropping an event is preferable to failing the traced code
+            }
+        }
+
+        bool writeJson(const std::string& filename) {
+            std::ofstream out(filename);
+            if (!out) {
+                return false;
+            }
+
+            const uint64_t session = currentSession.load(std::memory_order_acquire);
+            std::lock_guard<std::mutex> lock(registryMutex);
+
+            out << std::fixed << std::setprecision(3);
+            out << "{\"traceEvents\":[\n";
+            bool first = true;
+            const auto separator = [&]() {
+                if (!first) out << ",\n";
+                first = false;
+            };
+
+            for (const auto& buffer : registry) {
+                if (!buffer->threadName.empty()) {
+                    separator();
+                    out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                        << ",\"args\":{\"name\":\"";
+                    writeEscaped(out, buffer->threadName.c_str());
+                    out << "\"}}";
+                }
+                if (buffer->sessionId != session) continue;
+
+                // Oldest first: after wrapping the ring starts at 'next'
+                const size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+                const size_t begin = buffer->wrapped ? buffer->next : 0;
+                for (size_t i = 0; i < count; ++i) {
+                    const Event& e = buffer->events[(begin + i) % buffer->events.size()];
+                    separator();
+                    out << "{\"ph\":\"X\",\"name\":\"";
+                    writeEscaped(out, e.name);
+                    out << "\",\"pid\":1,\"tid\":" << buffer->threadId
+                        << ",\"ts\":" << static_cast<double>(e.startNs) / 1000.0
+                        << ",\"dur\":" << static_cast<double>(e.endNs - e.startNs) / 1000.0 << "}";
+                }
+            }
+
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+            return out.good();
+        }
+    }
+}
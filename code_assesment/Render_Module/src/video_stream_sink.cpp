@@ -0,0 +1,258 @@
+#include "video_stream_sink.h"
+#include <string>
+#include <stdexcept>
+#include "trace.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#define RENDER_FDOPEN _fdopen
+#else
+#define RENDER_FDOPEN fdopen
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RENDER_HAS_SSE2 1
+#endif
+
+namespace Render {
+    namespace VideoConvert {
+        namespace {
+            // Y = (77R + 150G + 29B + 128) >> 8
+            inline uint8_t luma(const Color& c) noexcept {
+                return static_cast<uint8_t>((77 * c.r + 150 * c.g + 29 * c.b + 128) >> 8);
+            }
+
+            inline uint8_t clampByte(int v) noexcept {
+                return static_cast<uint8_t>(v < 0 ? 0 : (v > 255 ? 255 : v));
+            }
+
+            // Chroma of one 2x2 block from its channel sums; sums are 4x the average, so shift by 10 instead of 8
+            inline uint8_t chromaU(int r, int g, int b) noexcept {
+                return clampByte(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128);
+            }
+
+            inline uint8_t chromaV(int r, int g, int b) noexcept {
+                return clampByte(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128);
+            }
+
+#ifdef RENDER_HAS_SSE2
+            static_assert(sizeof(Color) == 3, "Deinterleaving assumes packed 3-byte pixels");
+
+            // 32 pixels (96 bytes) from six 16-byte loads into channel planes: out[0..1] = R, out[2..3] = G,
+            // out[4..5] = B, each pair holding pixels 0-15 and 16-31. Each round interleaves bytes of
+            // v[k] with v[k + 3]; that moves byte j to position 32j mod 95, so five rounds sort the 96
+            // bytes by channel and then pixel.
+            inline void deinterleave32(const Color* pixels, __m128i out[6]) noexcept {
+                const auto* bytes = reinterpret_cast<const __m128i*>(pixels);
+                __m128i v[6];
+                for (int k = 0; k < 6; ++k) {
+                    v[k] = _mm_loadu_si128(bytes + k);
+                }
+                for (int round = 0; round < 5; ++round) {
+                    const __m128i t0 = _mm_unpacklo_epi8(v[0], v[3]);
+                    const __m128i t1 = _mm_unpackhi_epi8(v[0], v[3]);
+                    const __m128i t2 = _mm_unpacklo_epi8(v[1], v[4]);
+                    const __m128i t3 = _mm_unpackhi_epi8(v[1], v[4]);
+                    const __m128i t4 = _mm_unpacklo_epi8(v[2], v[5]);
+                    const __m128i t5 = _mm_unpackhi_epi8(v[2], v[5]);
+                    v[0] = t0; v[1] = t1; v[2] = t2; v[3] = t3; v[4] = t4; v[5] = t5;
+                }
+                for (int k = 0; k < 6; ++k) {
+                    out[k] = v[k];
+                }
+            }
+
+            // Luma of 8 pixels in 16-bit lanes; the weighted sum peaks at 65408 so it fits unsigned
+            inline __m128i luma8(__m128i r, __m128i g, __m128i b) noexcept {
+                __m128i sum = _mm_add_epi16(_mm_mullo_epi16(r, _mm_set1_epi16(77)), _mm_mullo_epi16(g, _mm_set1_epi16(150)));
+                sum = _mm_add_epi16(sum, _mm_mullo_epi16(b, _mm_set1_epi16(29)));
+                return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(128)), 8);
+            }
+
+            // Luma of 16 pixels given as channel planes
+            inline void storeLuma16(__m128i r, __m128i g, __m128i b, uint8_t* y) noexcept {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i lo = luma8(_mm_unpacklo_epi8(r, zero), _mm_unpacklo_epi8(g, zero), _mm_unpacklo_epi8(b, zero));
+                const __m128i hi = luma8(_mm_unpackhi_epi8(r, zero), _mm_unpackhi_epi8(g, zero), _mm_unpackhi_epi8(b, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(y), _mm_packus_epi16(lo, hi));
+            }
+
+            // 2x2 sums of one channel over 16 pixels of two rows, as 8 16-bit lanes
+            inline __m128i blockSums8(__m128i row0, __m128i row1) noexcept {
+                const __m128i even = _mm_set1_epi16(0x00FF);
+                const __m128i top = _mm_add_epi16(_mm_and_si128(row0, even), _mm_srli_epi16(row0, 8));
+                const __m128i bottom = _mm_add_epi16(_mm_and_si128(row1, even), _mm_srli_epi16(row1, 8));
+                return _mm_add_epi16(top, bottom);
+            }
+
+            // chromaU/chromaV for 8 blocks: weights (wr, wg) apply to r, g via madd and (wb, 1) to (b, 512)
+            inline __m128i chroma8(__m128i r, __m128i g, __m128i b, __m128i rgWeights, __m128i bWeights) noexcept {
+                const __m128i bias = _mm_set1_epi16(512);
+                const __m128i lo = _mm_srai_epi32(_mm_add_epi32(
+                    _mm_madd_epi16(_mm_unpacklo_epi16(r, g), rgWeights),
+                    _mm_madd_epi16(_mm_unpacklo_epi16(b, bias), bWeights)), 10);
+                const __m128i hi = _mm_srai_epi32(_mm_add_epi32(
+                    _mm_madd_epi16(_mm_unpackhi_epi16(r, g), rgWeights),
+                    _mm_madd_epi16(_mm_unpackhi_epi16(b, bias), bWeights)), 10);
+                return _mm_add_epi16(_mm_packs_epi32(lo, hi), _mm_set1_epi16(128));
+            }
+#endif
+        }
+
+        void rgbToYUV420(const Color* pixels, int width, int height,
+            uint8_t* yPlane, uint8_t* uPlane, uint8_t* vPlane) noexcept {
+            const int chromaWidth = (width + 1) / 2;
+            const int chromaHeight = (height + 1) / 2;
+#ifdef RENDER_HAS_SSE2
+            const __m128i uRG = _mm_setr_epi16(-43, -85, -43, -85, -43, -85, -43, -85);
+            const __m128i uB = _mm_setr_epi16(128, 1, 128, 1, 128, 1, 128, 1);
+            const __m128i vRG = _mm_setr_epi16(128, -107, 128, -107, 128, -107, 128, -107);
+            const __m128i vB = _mm_setr_epi16(-21, 1, -21, 1, -21, 1, -21, 1);
+#endif
+
+            // One pass per row pair: both luma rows and their chroma row. An odd last row pairs with itself.
+            for (int cy = 0; cy < chromaHeight; ++cy) {
+                const Color* row0 = pixels + static_cast<size_t>(2 * cy) * width;
+                const bool pair = 2 * cy + 1 < height;
+                const Color* row1 = pair ? row0 + width : row0;
+                uint8_t* y0 = yPlane + static_cast<size_t>(2 * cy) * width;
+                uint8_t* y1 = y0 + width;
+                uint8_t* u = uPlane + static_cast<size_t>(cy) * chromaWidth;
+                uint8_t* v = vPlane + static_cast<size_t>(cy) * chromaWidth;
+
+                int x = 0;
+#ifdef RENDER_HAS_SSE2
+                for (; x + 32 <= width; x += 32) {
+                    __m128i top[6], bottom[6];
+                    deinterleave32(row0 + x, top);
+                    deinterleave32(row1 + x, bottom);
+
+                    storeLuma16(top[0], top[2], top[4], y0 + x);
+                    storeLuma16(top[1], top[3], top[5], y0 + x + 16);
+                    if (pair) {
+                        storeLuma16(bottom[0], bottom[2], bottom[4], y1 + x);
+                        storeLuma16(bottom[1], bottom[3], bottom[5], y1 + x + 16);
+                    }
+
+                    __m128i uHalves[2], vHalves[2];
+                    for (int h = 0; h < 2; ++h) {
+                        const __m128i r = blockSums8(top[h], bottom[h]);
+                        const __m128i g = blockSums8(top[2 + h], bottom[2 + h]);
+                        const __m128i b = blockSums8(top[4 + h], bottom[4 + h]);
+                        uHalves[h] = chroma8(r, g, b, uRG, uB);
+                        vHalves[h] = chroma8(r, g, b, vRG, vB);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x / 2), _mm_packus_epi16(uHalves[0], uHalves[1]));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(v + x / 2), _mm_packus_epi16(vHalves[0], vHalves[1]));
+                }
+#endif
+                for (int lx = x; lx < width; ++lx) {
+                    y0[lx] = luma(row0[lx]);
+                    if (pair) y1[lx] = luma(row1[lx]);
+                }
+                for (int cx = x / 2; cx < chromaWidth; ++cx) {
+                    const int x0 = 2 * cx;
+                    const int x1 = (x0 + 1 < width) ? x0 + 1 : x0;
+
+                    const int r = row0[x0].r + row0[x1].r + row1[x0].r + row1[x1].r;
+                    const int g = row0[x0].g + row0[x1].g + row1[x0].g + row1[x1].g;
+                    const int b = row0[x0].b + row0[x1].b + row1[x0].b + row1[x1].b;
+                    u[cx] = chromaU(r, g, b);
+                    v[cx] = chromaV(r, g, b);
+                }
+            }
+        }
+    }
+
+    VideoStreamSink::VideoStreamSink(int width, int height, std::FILE* stream, StreamFormat format, int fps)
+        : frame(width, height), out(stream), ownsStream(false), format(format), framesPerSecond(fps > 0 ? fps : 30) {
+        if (!out) {
+            throw std::runtime_error("VideoStreamSink requires an open stream");
+        }
+    }
+
+    VideoStreamSink::~VideoStreamSink() {
+        if (!out) return;
+        std::fflush(out);
+        if (ownsStream) {
+            std::fclose(out);
+        }
+    }
+
+    std::unique_ptr<VideoStreamSink> VideoStreamSink::toStdout(int width, int height, StreamFormat format, int fps) {
+#if defined(_WIN32)
+        _setmode(_fileno(stdout), _O_BINARY);
+#endif
+        return std::make_unique<VideoStreamSink>(width, height, stdout, format, fps);
+    }
+
+    std::unique_ptr<VideoStreamSink> VideoStreamSink::toDescriptor(int fd, int width, int height, StreamFormat format, int fps) {
+        std::FILE* stream = RENDER_FDOPEN(fd, "wb");
+        if (!stream) {
+            throw std::runtime_error("Failed to open descriptor " + std::to_string(fd) + " for streaming");
+        }
+        auto sink = std::make_unique<VideoStreamSink>(width, height, stream, format, fps);
+        sink->ownsStream = true;
+        return sink;
+    }
+
+    bool VideoStreamSink::writeHeader() noexcept {
+        if (format == StreamFormat::Y4M) {
+            if (std::fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+                frame.getWidth(), frame.getHeight(), framesPerSecond) < 0) {
+                return false;
+            }
+        }
+        headerWritten = true;
+        return true;
+    }
+
+    bool VideoStreamSink::writeFrame() noexcept {
+        return writeFrame(frame);
+    }
+
+    bool VideoStreamSink::writeFrame(const FrameBuffer& source) noexcept {
+        RENDER_TRACE_SCOPE("VideoStreamSink::writeFrame");
+        if (source.getWidth() != frame.getWidth() || source.getHeight() != frame.getHeight()) {
+            return false;
+        }
+        if (!headerWritten && !writeHeader()) {
+            return false;
+        }
+
+        const int width = source.getWidth();
+        const int height = source.getHeight();
+        const auto& pixels = source.getPixels();
+
+        if (format == StreamFormat::RawRGB) {
+            if (std::fwrite(pixels.data(), sizeof(Color), pixels.size(), out) != pixels.size()) {
+                return false;
+            }
+        }
+        else {
+            const size_t lumaSize = static_cast<size_t>(width) * height;
+            const size_t chromaSize = static_cast<size_t>((width + 1) / 2) * ((height + 1) / 2);
+            try {
+                yuvScratch.resize(lumaSize + 2 * chromaSize);
+            }
+            catch (const std::exception&) {
+                return false;
+            }
+
+            uint8_t* yPlane = yuvScratch.data();
+            VideoConvert::rgbToYUV420(pixels.data(), width, height,
+                yPlane, yPlane + lumaSize, yPlane + lumaSize + chromaSize);
+
+            static constexpr char frameTag[] = "FRAME\n";
+            if (std::fwrite(frameTag, 1, sizeof(frameTag) - 1, out) != sizeof(frameTag) - 1 ||
+                std::fwrite(yuvScratch.data(), 1, yuvScratch.size(), out) != yuvScratch.size()) {
+                return false;
+            }
+        }
+
+        framesWritten++;
+        return true;
+    }
+}
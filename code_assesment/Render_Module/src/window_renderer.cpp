@@ -5,8 +5,12 @@
 #include "renderer.h"
 #include "framebuffer.h"
 #include "wireframe.h"
+#include "transformed_object_cache.h"
+#include "multi_viewport.h"
 #include "object_loader.h"
 #include "transformation.h"
+#include "quaternion.h"
+#include "trace.h"
 
 #define IDM_FILE_OPEN 1001
 #define IDM_FILE_EXIT 1002
@@ -37,18 +41,40 @@ namespace Render {
         bool mouseDown;
         int lastMouseX;
         int lastMouseY;
-        float rotationX;
-        float rotationY;
+        Math::ArcballController arcball;
+        uint64_t appliedRotationRevision = 0; // Arcball revision the pipeline was last built from
         bool isDragging;
         float viewDistance;
+        LineMode lineMode = LineMode::Aliased;
+        bool hiddenLines = false;
+        bool densityMode = false; // Point-cloud density image instead of edges and vertex dots
+
+        // Frame timing
+        std::shared_ptr<RenderStats> stats = std::make_shared<RenderStats>();
+        double lastFrameInterval = 0.0;
+
+        // Reused across frames so a steady-state frame does not allocate
+        std::shared_ptr<FrameBuffer> frameBuffer;
+        std::unique_ptr<Renderer> renderer;
+        TransformedObjectCache transformedCache;
+
+        // Quad view: front, side and top orthographic views plus the mouse-driven perspective view
+        bool quadView = false;
+        MultiViewportRenderer quadViews;
+
+        // Background file load; swapped in by the render timer once finished
+        std::unique_ptr<LoadHandle> pendingLoad;
+        std::chrono::steady_clock::time_point pendingLoadStart;
 
         UINT_PTR renderTimer;
 
+        // Set when a frame threw; rendering stops until the next load or resize so the error is shown once
+        bool renderFailed = false;
+
         // Constructor
         Impl(HWND hwnd, int width, int height)
             : hwnd(hwnd), width(width), height(height),
             objectLoaded(false), mouseDown(false),
-            rotationX(0.0f), rotationY(0.0f),
             memDC(NULL), memBitmap(NULL), oldBitmap(NULL) {
 
             HMENU hMenu = CreateMenu();
@@ -94,8 +120,7 @@ namespace Render {
         }
 
         void ResetView() {
-            rotationX = 0.0f;
-            rotationY = 0.0f;
+            arcball.reset();
             AdjustViewForObject();
             UpdateTransformation();
             InvalidateRect(hwnd, NULL, TRUE);
@@ -114,61 +139,174 @@ namespace Render {
             oldBitmap = (HBITMAP)SelectObject(memDC, memBitmap);
         }
 
+        // RenderFrame for the paint and timer handlers, which must not let an exception escape
+        void PaintFrame() {
+            if (renderFailed) return;
+            try {
+                RenderFrame();
+            }
+            catch (const std::exception& e) {
+                renderFailed = true;
+                MessageBoxA(hwnd, e.what(), "Error", MB_ICONERROR);
+            }
+        }
+
         // Render current frame
         void RenderFrame() {
-            // Create frame buffer for the current size
-            auto frameBuffer = std::make_shared<FrameBuffer>(width, height);
-            Renderer renderer(frameBuffer);
+            // (Re)create the frame buffer only when the size changes
+            if (!frameBuffer || frameBuffer->getWidth() != width || frameBuffer->getHeight() != height) {
+                frameBuffer = std::make_shared<FrameBuffer>(width, height);
+                renderer = std::make_unique<Renderer>(frameBuffer);
+                renderer->setStats(stats);
+                quadViews.clearViewports();
+            }
+            renderer->setLineMode(lineMode);
+            renderer->setHiddenLineRemoval(hiddenLines);
+            renderer->beginFrame();
+
+            // Drags since the last frame only touched the arcball; fold them into the pipeline once
+            if (arcball.getRevision() != appliedRotationRevision) {
+                UpdateTransformation();
+            }
+
+            // Wall-clock interval since the previous frame
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            lastFrameInterval = static_cast<double>(now.QuadPart - lastTime.QuadPart) / static_cast<double>(frequency.QuadPart);
+            lastTime = now;
 
             // Clear with black background
-            renderer.clear(Color::Black());
+            renderer->clear(Color::Black());
 
             // Render object if loaded
-            if (objectLoaded && object && !object->getVertices().empty()) {
-                // Create a copy of the object
-                WireframeObject transformedObject = *object;
-
-                // Apply transformations
-                transformedObject.transform(transformPipeline.getTransformMatrix());
+            if (quadView && objectLoaded && object && !object->getVertices().empty()) {
+                RenderQuadView();
+            }
+            else if (objectLoaded && object && !object->getVertices().empty()) {
+                // Bring the world-space copy up to date; edits to the object only redo the changed ranges
+                {
+                    ScopedStageTimer timer(stats.get(), RenderStage::Transform);
+                    transformedCache.update(*object, transformPipeline.getTransformMatrix());
+                }
+                const WireframeObject& transformedObject = transformedCache.get();
 
                 //Check if transformed object has valid coordinates
                 bool validObject = true;
-                for (const auto& vertex : transformedObject.getVertices()) {
-                    const auto& pos = vertex.getPosition();
-                    if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z) ||
-                        !std::isfinite(pos.x) || !std::isfinite(pos.y) || !std::isfinite(pos.z)) {
-                        validObject = false;
-                        break;
+                {
+                    ScopedStageTimer timer(stats.get(), RenderStage::Validation);
+                    for (const auto& vertex : transformedObject.getVertices()) {
+                        const auto& pos = vertex.getPosition();
+                        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z) ||
+                            !std::isfinite(pos.x) || !std::isfinite(pos.y) || !std::isfinite(pos.z)) {
+                            validObject = false;
+                            break;
+                        }
                     }
                 }
 
 
                 // Render the transformed object only if valid coordinates
-                if (validObject) {
-                    renderer.drawWireframeObject(transformedObject, 3, Color::Blue());
+                if (validObject && densityMode) {
+                    renderer->drawPointDensity(transformedObject);
+                }
+                else if (validObject) {
+                    renderer->drawWireframeObject(transformedObject, 3, Color::Blue());
                 }
                 else {
+                    renderer->endFrame();
                     ResetView();
                     return;
                 }
             }
 
-            // Copy frame buffer to the device context
-            for (int y = 0; y < height; ++y) {
-                for (int x = 0; x < width; ++x) {
-                    Color color = frameBuffer->getPixel(x, y);
-                    SetPixel(memDC, x, y, RGB(color.r, color.g, color.b));
+            {
+                ScopedStageTimer timer(stats.get(), RenderStage::Present);
+
+                // Copy frame buffer to the device context
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        Color color = frameBuffer->getPixel(x, y);
+                        SetPixel(memDC, x, y, RGB(color.r, color.g, color.b));
+                    }
+                }
+
+                // Display instructions
+                SetTextColor(memDC, RGB(255, 255, 255));
+                SetBkMode(memDC, TRANSPARENT);
+                RECT textRect = { 10, 10, width - 10, 30 };
+                DrawText(memDC, TEXT("Left-click and drag to rotate. A: anti-aliasing, H: hidden lines, V: quad view, D: density."), -1, &textRect, DT_LEFT);
+
+                // Frame budget overlay (rolling percentiles of the render work)
+                const PercentileSummary frameTimes = stats->framePercentiles();
+                char timing[128];
+                sprintf_s(timing, "frame p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  interval %.1f ms",
+                    frameTimes.p50 * 1e3, frameTimes.p95 * 1e3, frameTimes.p99 * 1e3, lastFrameInterval * 1e3);
+                RECT timingRect = { 10, 30, width - 10, 50 };
+                DrawTextA(memDC, timing, -1, &timingRect, DT_LEFT);
+
+                if (pendingLoad) {
+                    const LoadProgress progress = pendingLoad->getProgress();
+                    char loading[128];
+                    if (pendingLoad->isCancelRequested()) {
+                        sprintf_s(loading, "Cancelling load...");
+                    }
+                    else {
+                        sprintf_s(loading, "Loading %.0f%%  (%zu vertices, %zu faces)  Esc: cancel",
+                            progress.fraction() * 100.0f, progress.verticesParsed, progress.facesParsed);
+                    }
+                    RECT loadingRect = { 10, 50, width - 10, 70 };
+                    DrawTextA(memDC, loading, -1, &loadingRect, DT_LEFT);
+                }
+
+                // Blit to the window
+                BitBlt(hdc, 0, 0, width, height, memDC, 0, 0, SRCCOPY);
+            }
+
+            renderer->endFrame();
+        }
+
+        // Four viewports over the one frame buffer; the object is shared in world space and each
+        // view applies its own camera while projecting
+        void RenderQuadView() {
+            if (quadViews.getViewportCount() == 0) {
+                const int halfWidth = width / 2;
+                const int halfHeight = height / 2;
+                const int rects[4][4] = {
+                    { 0, 0, halfWidth, halfHeight },
+                    { halfWidth, 0, width - halfWidth, halfHeight },
+                    { 0, halfHeight, halfWidth, height - halfHeight },
+                    { halfWidth, halfHeight, width - halfWidth, height - halfHeight }
+                };
+                for (const auto& rect : rects) {
+                    Viewport viewport;
+                    viewport.target = std::make_shared<ViewportTarget>(frameBuffer, rect[0], rect[1], rect[2], rect[3]);
+                    quadViews.addViewport(std::move(viewport));
                 }
             }
 
-            // Display instructions
-            SetTextColor(memDC, RGB(255, 255, 255));
-            SetBkMode(memDC, TRANSPARENT);
-            RECT textRect = { 10, 10, width - 10, 30 };
-            DrawText(memDC, TEXT("Left-click and drag to rotate."), -1, &textRect, DT_LEFT);
+            // Cameras follow the current view distance and mouse rotation
+            quadViews.getViewport(0).camera.view = MultiViewportRenderer::frontView(viewDistance);
+            quadViews.getViewport(1).camera.view = MultiViewportRenderer::sideView(viewDistance);
+            quadViews.getViewport(2).camera.view = MultiViewportRenderer::topView(viewDistance);
+            ViewTransform& perspective = quadViews.getViewport(3).camera;
+            perspective.view = transformPipeline.getTransformMatrix();
+            perspective.projection = Projection::Perspective;
+            perspective.focalLength = viewDistance;
+            for (size_t i = 0; i < quadViews.getViewportCount(); ++i) {
+                quadViews.getViewport(i).lineMode = lineMode;
+                quadViews.getViewport(i).hiddenLines = hiddenLines;
+            }
+
+            {
+                // The object has no model transform here, so it is drawn without a world-space copy
+                ScopedStageTimer timer(stats.get(), RenderStage::Rasterization);
+                quadViews.draw(*object);
+            }
 
-            // Blit to the window
-            BitBlt(hdc, 0, 0, width, height, memDC, 0, 0, SRCCOPY);
+            // Separators between the views
+            const Color separator(64, 64, 64);
+            GraphicsPrimitives::drawLine(*frameBuffer, width / 2, 0, width / 2, height - 1, separator);
+            GraphicsPrimitives::drawLine(*frameBuffer, 0, height / 2, width - 1, height / 2, separator);
         }
 
         // Mouse movement handler
@@ -180,20 +318,8 @@ namespace Render {
                 int deltaX = x - lastMouseX;
                 int deltaY = y - lastMouseY;
 
-                // Update rotation angles
-                const float rotationFactor = 0.005f;
-                rotationY += deltaX * rotationFactor;
-                rotationX += deltaY * rotationFactor;
-
-                // Clamp rotation angles
-                const float PI = 3.14159265359f;
-                while (rotationX > PI) rotationX -= 2.0f * PI;
-                while (rotationX < -PI) rotationX += 2.0f * PI;
-                while (rotationY > PI) rotationY -= 2.0f * PI;
-                while (rotationY < -PI) rotationY += 2.0f * PI;
-
-                // Update transformation
-                UpdateTransformation();
+                // Incremental quaternion update; the pipeline is rebuilt by the next frame
+                arcball.drag(deltaX, deltaY);
 
                 // Update mouse position
                 lastMouseX = x;
@@ -207,16 +333,9 @@ namespace Render {
         void AdjustViewForObject() {
             if (!object) return;
 
-            float maxDist = 0.0f;
-            const auto& vertices = object->getVertices();
-
-            if (!vertices.empty()) {
-                for (const auto& vertex : vertices) {
-                    const auto& pos = vertex.getPosition();
-                    float dist = std::sqrt(pos.x * pos.x + pos.y * pos.y + pos.z * pos.z);
-                    maxDist = std::max(maxDist, dist);
-                }
-
+            if (!object->getVertices().empty()) {
+                // Cached on the object; only recomputed after its vertices change
+                const float maxDist = object->getBoundingSphere().reachFromOrigin();
                 viewDistance = std::max(3.0f, maxDist * 2.5f);
             }
             else {
@@ -228,9 +347,9 @@ namespace Render {
         void UpdateTransformation() {
             transformPipeline.clear();
 
-            // Apply rotations
-            transformPipeline.addRotationX(rotationX);
-            transformPipeline.addRotationY(rotationY);
+            // Orientation from the arcball, then move the object out in front of the camera
+            transformPipeline.addMatrix(arcball.getMatrix());
+            appliedRotationRevision = arcball.getRevision();
 
             transformPipeline.addTranslation(0.0f, 0.0f, -viewDistance);
         }
@@ -285,7 +404,7 @@ namespace Render {
             PAINTSTRUCT ps;
             BeginPaint(hwnd, &ps);
             if (initialized && pImpl) {
-                pImpl->RenderFrame();
+                pImpl->PaintFrame();
             }
             EndPaint(hwnd, &ps);
             return 0;
@@ -294,7 +413,11 @@ namespace Render {
         case WM_TIMER:
             // Render on timer for smooth animation
             if (initialized && pImpl) {
-                pImpl->RenderFrame();
+                // Swap in a finished background load between frames
+                if (pImpl->pendingLoad && pImpl->pendingLoad->isReady()) {
+                    FinishPendingLoad();
+                }
+                pImpl->PaintFrame();
             }
             return 0;
 
@@ -338,11 +461,67 @@ namespace Render {
             return 0;
 
         case WM_KEYDOWN: // Add Reset
-            if (wParam == VK_ESCAPE || wParam == 'R') {
+            if (wParam == VK_ESCAPE && initialized && pImpl && pImpl->pendingLoad) {
+                // Escape cancels a running load before it resets the view
+                pImpl->pendingLoad->cancel();
+            }
+            else if (wParam == VK_ESCAPE || wParam == 'R') {
                 if (initialized && pImpl) {
                     pImpl->ResetView();
                 }
             }
+            else if (wParam == 'A') {
+                if (initialized && pImpl) {
+                    // Cycle Aliased -> AntiAliased -> SubPixel
+                    switch (pImpl->lineMode) {
+                    case LineMode::Aliased: pImpl->lineMode = LineMode::AntiAliased; break;
+                    case LineMode::AntiAliased: pImpl->lineMode = LineMode::SubPixel; break;
+                    default: pImpl->lineMode = LineMode::Aliased; break;
+                    }
+                    InvalidateRect(hwnd, NULL, FALSE);
+                }
+            }
+#ifdef RENDER_ENABLE_TRACING
+            else if (wParam == 'T') {
+                // Toggle a trace session; stopping writes render_trace.json next to the executable
+                if (Trace::isEnabled()) {
+                    Trace::stop();
+                    char modulePath[MAX_PATH];
+                    const DWORD length = GetModuleFileNameA(NULL, modulePath, MAX_PATH);
+                    std::string path = (length > 0 && length < MAX_PATH) ? std::string(modulePath, length) : std::string();
+                    const size_t slash = path.find_last_of("\\/");
+                    path = (slash == std::string::npos) ? std::string("render_trace.json") : path.substr(0, slash + 1) + "render_trace.json";
+                    if (Trace::writeJson(path)) {
+                        MessageBoxA(hwnd, ("Trace written to " + path).c_str(), "Trace", MB_ICONINFORMATION);
+                    }
+                    else {
+                        MessageBoxA(hwnd, ("Failed to write trace: " + path).c_str(), "Error", MB_ICONERROR);
+                    }
+                }
+                else {
+                    Trace::start();
+                    RENDER_TRACE_THREAD_NAME("ui");
+                }
+            }
+#endif
+            else if (wParam == 'H') {
+                if (initialized && pImpl) {
+                    pImpl->hiddenLines = !pImpl->hiddenLines;
+                    InvalidateRect(hwnd, NULL, FALSE);
+                }
+            }
+            else if (wParam == 'D') {
+                if (initialized && pImpl) {
+                    pImpl->densityMode = !pImpl->densityMode;
+                    InvalidateRect(hwnd, NULL, FALSE);
+                }
+            }
+            else if (wParam == 'V') {
+                if (initialized && pImpl) {
+                    pImpl->quadView = !pImpl->quadView;
+                    InvalidateRect(hwnd, NULL, FALSE);
+                }
+            }
             return 0;
         }
 
@@ -410,10 +589,10 @@ namespace Render {
             pImpl->objectCache.push_back(sharedObject);
             pImpl->object = sharedObject; // Change type to std::shared_ptr
             pImpl->objectLoaded = true;
+            pImpl->renderFailed = false;
 
             // Reset view parameters
-            pImpl->rotationX = 0.0f;
-            pImpl->rotationY = 0.0f;
+            pImpl->arcball.reset();
             pImpl->AdjustViewForObject();
 
             InvalidateRect(pImpl->hwnd, NULL, TRUE);
@@ -438,6 +617,7 @@ namespace Render {
         if (pImpl) {  // Check if pImpl is valid
             pImpl->width = width;
             pImpl->height = height;
+            pImpl->renderFailed = false;
             pImpl->CreateBackBuffer();
             InvalidateRect(pImpl->hwnd, NULL, TRUE);
         }
@@ -457,19 +637,50 @@ namespace Render {
         ofn.hwndOwner = pImpl->hwnd;
         ofn.lpstrFile = szFile;
         ofn.nMaxFile = sizeof(szFile);
-        ofn.lpstrFilter = "CSV Files\0*.csv\0All Files\0*.*\0";
+        ofn.lpstrFilter = "Meshes (CSV, STL, PLY, OBJ)\0*.csv;*.stl;*.ply;*.obj\0All Files\0*.*\0";
         ofn.nFilterIndex = 1;
         ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST;
 
         if (GetOpenFileNameA(&ofn)) {
-            try {
-                ObjectLoader loader([]() { return std::make_unique<WireframeObject>(); });
-                auto newObject = loader.loadFromCSV(ofn.lpstrFile);
-                LoadObject(std::move(newObject));
-            }
-            catch (const std::exception& e) {
-                MessageBoxA(pImpl->hwnd, e.what(), "Error", MB_ICONERROR);
+            LoadFile(ofn.lpstrFile);
+        }
+    }
+
+    void WindowRenderer::LoadFile(const std::string& path) {
+        if (!initialized || !pImpl) return;
+
+        try {
+            // Replacing a pending load cancels it (the handle waits for its worker)
+            pImpl->pendingLoad.reset();
+
+            ObjectLoader loader([]() { return std::make_unique<WireframeObject>(); });
+            pImpl->pendingLoad = std::make_unique<LoadHandle>(loader.loadFromFileAsync(path));
+            pImpl->pendingLoadStart = std::chrono::steady_clock::now();
+        }
+        catch (const std::exception& e) {
+            MessageBoxA(pImpl->hwnd, e.what(), "Error", MB_ICONERROR);
+        }
+    }
+
+    void WindowRenderer::FinishPendingLoad() {
+        if (!initialized || !pImpl || !pImpl->pendingLoad) return;
+
+        std::unique_ptr<LoadHandle> load = std::move(pImpl->pendingLoad);
+        try {
+            std::unique_ptr<WireframeObject> newObject = load->get();
+
+            // Wall time from the request to the swap-in; reported in the next frame's stats
+            if (pImpl->stats) {
+                pImpl->stats->addStageTime(RenderStage::Load,
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - pImpl->pendingLoadStart).count());
             }
+            LoadObject(std::move(newObject));
+        }
+        catch (const LoadCancelled&) {
+            InvalidateRect(pImpl->hwnd, NULL, FALSE);
+        }
+        catch (const std::exception& e) {
+            MessageBoxA(pImpl->hwnd, e.what(), "Error", MB_ICONERROR);
         }
     }
 }
\ No newline at end of file
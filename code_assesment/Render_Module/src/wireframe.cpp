@@ -8,13 +8,9 @@ namespace Render {
         constexpr Color vertexColor = Color::Red();
 
         // Draw all edges
-        for (const auto& edge : edges) {
-            if (edge.getVertex1Index() < vertices.size() && edge.getVertex2Index() < vertices.size()) {
-                const auto& v1 = vertices[edge.getVertex1Index()].getPosition();
-                const auto& v2 = vertices[edge.getVertex2Index()].getPosition();
-                renderer.drawEdge(v1, v2, edgeColor);
-            }
-        }
+        visitEdges([&](auto edgeSpan) {
+            renderer.drawEdgeBatch(vertices, edgeSpan, edgeColor, hasValidEdgeIndices());
+        });
 
         // Draw all vertices
         for (const auto& vertex : vertices) {
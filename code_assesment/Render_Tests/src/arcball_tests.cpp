@@ -0,0 +1,102 @@
+#include <cmath>
+#include "test_harness.h"
+#include "matrix4x4.h"
+#include "quaternion.h"
+
+namespace {
+    using Math::ArcballController;
+    using Math::Matrix4x4;
+    using Math::Quaternion;
+
+    constexpr float RadiansPerPixel = 0.01f;
+
+    // Compares the 3x3 rotation parts
+    [[nodiscard]] bool sameRotation(const Matrix4x4& a, const Matrix4x4& b, float tolerance = 1e-5f) noexcept {
+        for (int row = 0; row < 3; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                if (std::fabs(a.get(row, col) - b.get(row, col)) > tolerance) return false;
+            }
+        }
+        return true;
+    }
+
+    // Rows of the 3x3 part are unit length and mutually perpendicular, and the determinant is +1
+    [[nodiscard]] bool isOrthonormal(const Matrix4x4& m, float tolerance) noexcept {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                float dot = 0.0f;
+                for (int k = 0; k < 3; ++k) dot += m.get(i, k) * m.get(j, k);
+                if (std::fabs(dot - (i == j ? 1.0f : 0.0f)) > tolerance) return false;
+            }
+        }
+        const float det =
+            m.get(0, 0) * (m.get(1, 1) * m.get(2, 2) - m.get(1, 2) * m.get(2, 1)) -
+            m.get(0, 1) * (m.get(1, 0) * m.get(2, 2) - m.get(1, 2) * m.get(2, 0)) +
+            m.get(0, 2) * (m.get(1, 0) * m.get(2, 1) - m.get(1, 1) * m.get(2, 0));
+        return std::fabs(det - 1.0f) <= tolerance;
+    }
+}
+
+RENDER_TEST(quaternionMatchesAxisRotations) {
+    for (const float angle : { -2.5f, -0.3f, 0.0f, 0.7f, 3.0f }) {
+        RENDER_CHECK(sameRotation(Quaternion::fromAxisAngle(Math::Vector3D(1.0f, 0.0f, 0.0f), angle).toMatrix(),
+            Matrix4x4::createRotationX(angle)));
+        RENDER_CHECK(sameRotation(Quaternion::fromAxisAngle(Math::Vector3D(0.0f, 1.0f, 0.0f), angle).toMatrix(),
+            Matrix4x4::createRotationY(angle)));
+        RENDER_CHECK(sameRotation(Quaternion::fromAxisAngle(Math::Vector3D(0.0f, 0.0f, 1.0f), angle).toMatrix(),
+            Matrix4x4::createRotationZ(angle)));
+    }
+}
+
+// q1 * q2 applies q2 first, like the matrix product
+RENDER_TEST(quaternionProductMatchesMatrixProduct) {
+    const Quaternion a = Quaternion::fromAxisAngle(Math::Vector3D(1.0f, 0.0f, 0.0f), 0.4f);
+    const Quaternion b = Quaternion::fromAxisAngle(Math::Vector3D(0.0f, 1.0f, 0.0f), -1.1f);
+    RENDER_CHECK(sameRotation((a * b).toMatrix(), a.toMatrix() * b.toMatrix()));
+    RENDER_CHECK(sameRotation((b * a).toMatrix(), b.toMatrix() * a.toMatrix()));
+}
+
+// A horizontal drag turns about Y, a vertical one about X
+RENDER_TEST(arcballAxisDragsMatchAxisRotations) {
+    ArcballController horizontal(RadiansPerPixel);
+    horizontal.drag(40, 0);
+    RENDER_CHECK(sameRotation(horizontal.getMatrix(), Matrix4x4::createRotationY(40 * RadiansPerPixel)));
+    horizontal.drag(-15, 0);
+    RENDER_CHECK(sameRotation(horizontal.getMatrix(), Matrix4x4::createRotationY(25 * RadiansPerPixel)));
+
+    ArcballController vertical(RadiansPerPixel);
+    vertical.drag(0, -30);
+    RENDER_CHECK(sameRotation(vertical.getMatrix(), Matrix4x4::createRotationX(-30 * RadiansPerPixel)));
+
+    // Later drags apply in view space, after the accumulated orientation
+    ArcballController both(RadiansPerPixel);
+    both.drag(50, 0);
+    both.drag(0, 20);
+    RENDER_CHECK(sameRotation(both.getMatrix(),
+        Matrix4x4::createRotationX(20 * RadiansPerPixel) * Matrix4x4::createRotationY(50 * RadiansPerPixel)));
+}
+
+RENDER_TEST(arcballStaysOrthonormalOverManyDrags) {
+    ArcballController arcball(RadiansPerPixel);
+    for (int i = 0; i < 100000; ++i) {
+        arcball.drag((i * 7) % 23 - 11, (i * 13) % 19 - 9);
+    }
+    RENDER_CHECK(isOrthonormal(arcball.getMatrix(), 1e-5f));
+    RENDER_CHECK(std::fabs(arcball.getOrientation().length() - 1.0f) < 1e-5f);
+}
+
+RENDER_TEST(arcballRevisionAndMatrixCache) {
+    ArcballController arcball(RadiansPerPixel);
+    const auto start = arcball.getRevision();
+    arcball.drag(0, 0); // No movement, no change
+    RENDER_CHECK(arcball.getRevision() == start);
+    RENDER_CHECK(sameRotation(arcball.getMatrix(), Matrix4x4()));
+
+    arcball.drag(10, 0);
+    RENDER_CHECK(arcball.getRevision() == start + 1);
+    RENDER_CHECK(sameRotation(arcball.getMatrix(), Matrix4x4::createRotationY(10 * RadiansPerPixel)));
+
+    arcball.reset();
+    RENDER_CHECK(arcball.getRevision() == start + 2);
+    RENDER_CHECK(sameRotation(arcball.getMatrix(), Matrix4x4()));
+}
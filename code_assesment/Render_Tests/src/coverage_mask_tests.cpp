@@ -0,0 +1,39 @@
+#include "test_harness.h"
+#include "coverage_mask.h"
+
+using Render::Color;
+using Render::CoverageMaskTarget;
+
+// At 1 bpp the palette is {black, blue}; a red line is nearer black but must still be recorded
+RENDER_TEST(oneBitMaskRecordsAnyNonBackgroundColor) {
+    CoverageMaskTarget mask(16, 4, 1);
+    mask.clear(Color::Black());
+    mask.setPixel(1, 0, Color::Red());
+    mask.setPixel(2, 0, Color(10, 10, 10));
+    mask.setPixel(3, 0, Color::Black());
+    RENDER_CHECK(mask.getIndex(1, 0) == 1);
+    RENDER_CHECK(mask.getIndex(2, 0) == 1);
+    RENDER_CHECK(mask.getIndex(3, 0) == 0);
+    RENDER_CHECK(mask.getIndex(0, 0) == 0);
+}
+
+RENDER_TEST(maskCoverageFollowsClearColor) {
+    CoverageMaskTarget mask(8, 1, 1);
+    mask.clear(Color::White());
+    mask.setPixel(0, 0, Color::White());
+    mask.setPixel(1, 0, Color::Black());
+    RENDER_CHECK(mask.getIndex(0, 0) == 0);
+    RENDER_CHECK(mask.getIndex(1, 0) == 1);
+}
+
+// Wider palettes keep exact matches and never resolve a write to an entry that repeats the background
+RENDER_TEST(paletteMaskMapsWritesToVisibleEntries) {
+    CoverageMaskTarget mask(8, 1, 4);
+    mask.clear(Color::Black());
+    mask.setPixel(0, 0, Color::Red());
+    mask.setPixel(1, 0, Color(10, 10, 10));
+    RENDER_CHECK(mask.getIndex(0, 0) == 3);
+    RENDER_CHECK(mask.getIndex(1, 0) != 0);
+    const Color shown = mask.getPixel(1, 0);
+    RENDER_CHECK((shown.r | shown.g | shown.b) != 0);
+}
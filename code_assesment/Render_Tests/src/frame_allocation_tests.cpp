@@ -0,0 +1,82 @@
+#include <memory>
+#include "test_harness.h"
+#include "alloc_counter.h"
+#include "batch_render.h"
+#include "frame_arena.h"
+#include "framebuffer.h"
+#include "mesh_generators.h"
+#include "renderer.h"
+
+namespace {
+    constexpr int WarmupFrames = 3;
+    constexpr int MeasuredFrames = 20;
+
+    // Heap allocations made by the calling thread over MeasuredFrames frames, after the renderer's
+    // arena and scratch buffers have been sized by WarmupFrames identical ones
+    [[nodiscard]] uint64_t allocationsPerWarmedFrames(Render::LineMode mode, bool hiddenLines) {
+        const auto mesh = Render::MeshGenerators::icosphere(3, 0.9f, hiddenLines);
+        auto frame = std::make_shared<Render::FrameBuffer>(320, 240);
+        Render::Renderer renderer(frame);
+        renderer.setLineMode(mode);
+        renderer.setHiddenLineRemoval(hiddenLines);
+        const Render::ViewTransform camera{ Render::CameraPath::fixed(30.0f, 20.0f, 5.0f).matrixAt(0, 1, 5.0f) };
+
+        const auto drawFrame = [&] {
+            renderer.beginFrame();
+            renderer.clear(Render::Color::Black());
+            renderer.drawWireframeObject(*mesh, camera, 2, Render::Color::White());
+            renderer.endFrame();
+        };
+
+        for (int i = 0; i < WarmupFrames; ++i) {
+            drawFrame();
+        }
+        const Render::ScopedAllocationCount allocations;
+        for (int i = 0; i < MeasuredFrames; ++i) {
+            drawFrame();
+        }
+        return allocations.delta();
+    }
+}
+
+// The test project defines RENDER_COUNT_ALLOCATIONS; without it every count reads zero
+RENDER_TEST(allocationCountingIsEnabled) {
+    RENDER_CHECK(Render::AllocationCounter::isEnabled());
+    const Render::ScopedAllocationCount allocations;
+    const auto probe = std::make_unique<int>(1);
+    RENDER_CHECK(allocations.delta() >= 1);
+}
+
+RENDER_TEST(warmedAliasedFramesDoNotAllocate) {
+    RENDER_CHECK(allocationsPerWarmedFrames(Render::LineMode::Aliased, false) == 0);
+}
+
+RENDER_TEST(warmedAntiAliasedFramesDoNotAllocate) {
+    RENDER_CHECK(allocationsPerWarmedFrames(Render::LineMode::AntiAliased, false) == 0);
+}
+
+RENDER_TEST(warmedHiddenLineFramesDoNotAllocate) {
+    RENDER_CHECK(allocationsPerWarmedFrames(Render::LineMode::Aliased, true) == 0);
+}
+
+RENDER_TEST(frameArenaResetCoalescesIntoOneBlock) {
+    Render::FrameArena arena(4096);
+    for (int i = 0; i < 8; ++i) {
+        (void)arena.allocate(3000, 16);
+    }
+    RENDER_CHECK(arena.getBlockCount() > 1);
+    const size_t capacity = arena.getCapacity();
+
+    arena.reset();
+    RENDER_CHECK(arena.getBlockCount() == 1);
+    RENDER_CHECK(arena.getCapacity() == capacity);
+    RENDER_CHECK(arena.getBytesUsed() == 0);
+
+    // The same frame now fits without growing
+    const Render::ScopedAllocationCount allocations;
+    for (int i = 0; i < 8; ++i) {
+        (void)arena.allocate(3000, 16);
+    }
+    RENDER_CHECK(allocations.delta() == 0);
+    RENDER_CHECK(arena.getBlockCount() == 1);
+}
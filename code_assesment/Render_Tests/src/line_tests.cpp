@@ -0,0 +1,139 @@
+#include <cmath>
+#include <cstdlib>
+#include "test_harness.h"
+#include "framebuffer.h"
+#include "depth_buffer.h"
+#include "graphics_primitaves.h"
+#include "subpixel_line.h"
+
+namespace {
+    using Render::Color;
+    using Render::FrameBuffer;
+
+    [[nodiscard]] bool isLit(const Color& pixel) noexcept {
+        return (pixel.r | pixel.g | pixel.b) != 0;
+    }
+
+    // True when every lit pixel lies within one pixel of the ideal line (x0,y0)-(x1,y1), measured
+    // along y, and at least 'minLit' pixels are lit
+    [[nodiscard]] bool litPixelsFollowLine(const FrameBuffer& frame, double x0, double y0, double x1, double y1, int minLit) {
+        int lit = 0;
+        for (int y = 0; y < frame.getHeight(); ++y) {
+            for (int x = 0; x < frame.getWidth(); ++x) {
+                if (!isLit(frame.getPixel(x, y))) continue;
+                ++lit;
+                const double ideal = y0 + (y1 - y0) * (x - x0) / (x1 - x0);
+                if (std::abs(y - ideal) > 1.0) return false;
+            }
+        }
+        return lit >= minLit;
+    }
+}
+
+// Minor coordinates beyond 16 bits used to overflow the 16.16 Wu accumulator
+RENDER_TEST(antiAliasedLineWithFarOffscreenEndpoint) {
+    FrameBuffer frame(200, 200);
+    frame.clear(Color::Black());
+    Render::GraphicsPrimitives::drawLineAA(frame, -100000, 40000, 150, 100, Color::White());
+    RENDER_CHECK(litPixelsFollowLine(frame, -100000, 40000, 150, 100, 150));
+}
+
+RENDER_TEST(antiAliasedSteepLineWithFarOffscreenEndpoint) {
+    FrameBuffer frame(200, 200);
+    frame.clear(Color::Black());
+    Render::GraphicsPrimitives::drawLineAA(frame, 40000, -100000, 100, 150, Color::White());
+
+    // Transposed: every lit pixel must lie within one pixel of the line along x
+    FrameBuffer transposed(200, 200);
+    transposed.clear(Color::Black());
+    for (int y = 0; y < 200; ++y) {
+        for (int x = 0; x < 200; ++x) {
+            transposed.setPixel(y, x, frame.getPixel(x, y));
+        }
+    }
+    RENDER_CHECK(litPixelsFollowLine(transposed, -100000, 40000, 150, 100, 150));
+}
+
+RENDER_TEST(antiAliasedLineEntirelyOffscreen) {
+    FrameBuffer frame(64, 64);
+    frame.clear(Color::Black());
+    Render::GraphicsPrimitives::drawLineAA(frame, -50000, 70000, -40000, 90000, Color::White());
+    Render::GraphicsPrimitives::drawLineAA(frame, 100, -100000, 200000, -30000, Color::White());
+    bool blank = true;
+    for (const Color& pixel : frame.getPixels()) {
+        blank = blank && !isLit(pixel);
+    }
+    RENDER_CHECK(blank);
+}
+
+RENDER_TEST(depthTestedAntiAliasedLineWithFarOffscreenEndpoint) {
+    FrameBuffer frame(200, 200);
+    frame.clear(Color::Black());
+    Render::DepthBuffer depth(200, 200);
+    depth.clear();
+    Render::GraphicsPrimitives::drawLineAADepthTested(frame, depth, -100000, 40000, 0.5f, 150, 100, 0.5f, Color::White(), 0.0f);
+    RENDER_CHECK(litPixelsFollowLine(frame, -100000, 40000, 150, 100, 150));
+}
+
+// With nothing in the depth buffer the depth-tested sub-pixel line lights exactly the plain one's pixels
+RENDER_TEST(depthTestedSubPixelLineMatchesPlainLine) {
+    using Render::GraphicsPrimitives::toFixed;
+    FrameBuffer plain(64, 48);
+    FrameBuffer tested(64, 48);
+    plain.clear(Color::Black());
+    tested.clear(Color::Black());
+    Render::DepthBuffer depth(64, 48);
+    depth.clear();
+    const float lines[][4] = { { 2.3f, 3.7f, 60.1f, 40.2f }, { 50.5f, 2.25f, 10.75f, 45.5f }, { 63.0f, 10.0f, 0.5f, 11.9f } };
+    for (const auto& l : lines) {
+        Render::GraphicsPrimitives::drawLineSubPixel(plain, toFixed(l[0]), toFixed(l[1]), toFixed(l[2]), toFixed(l[3]), Color::White());
+        Render::GraphicsPrimitives::drawLineSubPixelDepthTested(tested, depth, toFixed(l[0]), toFixed(l[1]), 1.0f,
+            toFixed(l[2]), toFixed(l[3]), 2.0f, Color::White(), 0.0f);
+    }
+    bool same = true;
+    for (int y = 0; y < 48; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            same = same && isLit(plain.getPixel(x, y)) == isLit(tested.getPixel(x, y));
+        }
+    }
+    RENDER_CHECK(same);
+}
+
+// A line whose depth runs from in front of an occluder to behind it is cut where it passes behind
+RENDER_TEST(depthTestedSubPixelLineIsHiddenBehindOccluder) {
+    using Render::GraphicsPrimitives::toFixed;
+    FrameBuffer frame(64, 8);
+    frame.clear(Color::Black());
+    Render::DepthBuffer depth(64, 8);
+    depth.clear();
+    depth.rasterizeTriangle(-10.0f, -10.0f, 2.0f, 200.0f, -10.0f, 2.0f, -10.0f, 200.0f, 2.0f);
+    Render::GraphicsPrimitives::drawLineSubPixelDepthTested(frame, depth, toFixed(0.0f), toFixed(4.5f), 1.0f,
+        toFixed(64.0f), toFixed(4.5f), 3.0f, Color::White(), 0.0f);
+    RENDER_CHECK(isLit(frame.getPixel(5, 4)));
+    RENDER_CHECK(isLit(frame.getPixel(30, 4)));
+    RENDER_CHECK(!isLit(frame.getPixel(34, 4)));
+    RENDER_CHECK(!isLit(frame.getPixel(60, 4)));
+}
+
+// Every destination, source and coverage must round d + (s - d) * c / 255 to nearest
+RENDER_TEST(blendPixelRoundsToNearest) {
+    FrameBuffer frame(1, 1);
+    bool exact = true;
+    for (int d = 0; d < 256 && exact; d += 3) {
+        for (int s = 0; s < 256 && exact; s += 5) {
+            for (int c = 1; c < 255 && exact; ++c) {
+                frame.setPixel(0, 0, Color(static_cast<uint8_t>(d), 0, 0));
+                Render::GraphicsPrimitives::blendPixel(frame, 0, 0, Color(static_cast<uint8_t>(s), 0, 0), c);
+                const int twice255 = 2 * (255 * d + (s - d) * c); // 510 * exact value
+                const int expected = (twice255 + 255) / 510;       // Never half way, and non-negative
+                exact = frame.getPixel(0, 0).r == expected;
+            }
+        }
+    }
+    RENDER_CHECK(exact);
+
+    // 1 + (0 - 1) * 128 / 255 = 0.498 used to round up to 1
+    frame.setPixel(0, 0, Color(1, 1, 1));
+    Render::GraphicsPrimitives::blendPixel(frame, 0, 0, Color(0, 0, 0), 128);
+    RENDER_CHECK(frame.getPixel(0, 0).r == 0);
+}
@@ -0,0 +1,220 @@
+// Console test runner: unit tests, then the golden-image regression suite (Render::RegressionSuite).
+//   Render_Tests [--filter <text>] [--no-regression]
+//                [--golden <dir>] [--update-golden] [--budgets <file>] [--update-budgets]
+//                [--runs <n>] [--tolerance <factor>] [--report <file>] [--stats]
+//   Render_Tests --benchmark [--benchmark-size <pixels>]
+// Golden images live in golden/ and are committed. Timing budgets are machine-specific: record them
+// with --budgets <file> --update-budgets on the machine that checks them, and keep the file out of
+// the repository. Without --budgets timings are reported but not checked, and a warning says so on stderr.
+// --stats prints each scene's per-stage frame time percentiles (Render::RenderStats) after the table.
+// --benchmark runs only the benchmarks: the render target benchmark (Render::benchmarkTarget) on a
+// FrameBuffer, TiledFrameBuffer and 1-bit CoverageMaskTarget of each size (default 1024 and 4096
+// square), then a size sweep of the mesh generators (icosphere levels 4..10, square grids) in
+// nanoseconds per edge.
+// Results go to stdout and failures to stderr. Exit code 0 when everything passes, 1 when a test or
+// scene fails, 2 on bad arguments or an unexpected error.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test_harness.h"
+#include "coverage_mask.h"
+#include "framebuffer.h"
+#include "mesh_generators.h"
+#include "regression_suite.h"
+#include "target_benchmark.h"
+#include "tiled_framebuffer.h"
+
+namespace {
+    struct RunnerOptions {
+        std::string filter;         // Only unit tests whose name contains this
+        bool regression = true;
+        bool benchmark = false;
+        std::vector<int> benchmarkSizes{ 1024, 4096 };
+        std::string reportFile;     // Regression report copy; stdout always gets one
+        Render::RegressionOptions suite;
+    };
+
+    [[nodiscard]] RunnerOptions parseArguments(int argc, char** argv) {
+        RunnerOptions options;
+        options.suite.goldenDirectory = "golden"; // Relative to the project directory, the debugger's working directory
+        for (int i = 1; i < argc; ++i) {
+            const std::string option = argv[i];
+            if (option == "--update-golden") {
+                options.suite.updateImages = true;
+                continue;
+            }
+            if (option == "--update-budgets") {
+                options.suite.updateBudgets = true;
+                continue;
+            }
+            if (option == "--benchmark") {
+                options.benchmark = true;
+                continue;
+            }
+            if (option == "--no-regression") {
+                options.regression = false;
+                continue;
+            }
+            if (option == "--stats") {
+                options.suite.collectStats = true;
+                continue;
+            }
+            if (i + 1 >= argc) throw std::invalid_argument("Missing value for " + option);
+            const std::string value = argv[++i];
+            if (option == "--filter") options.filter = value;
+            else if (option == "--golden") options.suite.goldenDirectory = value;
+            else if (option == "--budgets") options.suite.budgetFile = value;
+            else if (option == "--runs") options.suite.timingRuns = std::atoi(value.c_str()); // Clamped to at least 1 by the suite
+            else if (option == "--tolerance") options.suite.budgetTolerance = std::strtod(value.c_str(), nullptr);
+            else if (option == "--report") options.reportFile = value;
+            else if (option == "--benchmark-size") {
+                const int size = std::atoi(value.c_str());
+                if (size <= 0) throw std::invalid_argument("Invalid value for --benchmark-size: " + value);
+                options.benchmarkSizes = { size };
+            }
+            else throw std::invalid_argument("Unknown option: " + option);
+        }
+        if (options.suite.updateBudgets && options.suite.budgetFile.empty()) {
+            throw std::invalid_argument("--update-budgets requires --budgets <file>");
+        }
+        return options;
+    }
+
+    // Number of failed tests
+    int runUnitTests(const std::string& filter) {
+        int failed = 0;
+        int run = 0;
+        for (const auto& test : Tests::registry()) {
+            if (!filter.empty() && std::string(test.name).find(filter) == std::string::npos) continue;
+            ++run;
+            Tests::TestContext context;
+            try {
+                test.run(context);
+            }
+            catch (const std::exception& e) {
+                context.check(false, e.what(), test.name, 0);
+            }
+            const bool passed = context.getFailures() == 0;
+            if (!passed) ++failed;
+            std::printf("%s\t%s\n", passed ? "ok" : "FAIL", test.name);
+        }
+        std::printf("%s\t%d/%d unit tests passed\n", failed == 0 ? "PASS" : "FAIL", run - failed, run);
+        return failed;
+    }
+
+    // Number of failed scenes
+    int runRegression(const RunnerOptions& options) {
+        if (options.suite.budgetFile.empty()) {
+            std::fprintf(stderr, "Warning: no --budgets file; scene timings are reported but not checked\n");
+        }
+        const auto results = Render::RegressionSuite::withDefaultScenes().run(options.suite);
+        Render::RegressionSuite::writeReport(std::cout, results);
+        for (const auto& result : results) {
+            if (!result.statsReport.empty()) {
+                std::cout << "# " << result.scene << '\n' << result.statsReport;
+            }
+        }
+        std::cout.flush();
+        if (!options.reportFile.empty()) {
+            std::ofstream report(options.reportFile);
+            if (!report.is_open()) {
+                throw std::runtime_error("Failed to open report: " + options.reportFile);
+            }
+            Render::RegressionSuite::writeReport(report, results);
+        }
+
+        int failed = 0;
+        for (const auto& result : results) {
+            if (!result.passed()) ++failed;
+        }
+        return failed;
+    }
+
+    // Same primitives on each layout; the target sizes should exceed the last-level cache
+    void runBenchmark(const std::vector<int>& sizes) {
+        std::cout << "target\tsteep_mpx_s\tshallow_mpx_s\tcircle_mpx_s\n";
+        for (const int size : sizes) {
+            const std::string suffix = "_" + std::to_string(size);
+            Render::FrameBuffer rowMajor(size, size);
+            Render::writeTargetBenchmark(std::cout, "framebuffer" + suffix, Render::benchmarkTarget(rowMajor));
+            Render::TiledFrameBuffer tiled(size, size);
+            Render::writeTargetBenchmark(std::cout, "tiled" + suffix, Render::benchmarkTarget(tiled));
+            Render::CoverageMaskTarget mask(size, size, 1);
+            Render::writeTargetBenchmark(std::cout, "coverage_mask" + suffix, Render::benchmarkTarget(mask));
+            std::cout.flush();
+        }
+    }
+
+    // Best of a few runs, so page faults of the first allocation don't dominate small meshes
+    template <typename Generate>
+    void writeGeneratorBenchmark(const std::string& name, Generate&& generate) {
+        constexpr int MaxRuns = 5;
+        constexpr double MinTotalSeconds = 0.5;
+        double best = 0.0;
+        double total = 0.0;
+        size_t vertices = 0;
+        size_t edges = 0;
+        for (int run = 0; run < MaxRuns && (run == 0 || total < MinTotalSeconds); ++run) {
+            const auto start = std::chrono::steady_clock::now();
+            const auto mesh = generate();
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            best = (run == 0) ? seconds : std::min(best, seconds);
+            total += seconds;
+            vertices = mesh->getVertices().size();
+            edges = mesh->getEdgeCount();
+        }
+        char numbers[96];
+        std::snprintf(numbers, sizeof(numbers), "%zu\t%zu\t%.3f\t%.3f", vertices, edges, best * 1e3,
+            edges > 0 ? best * 1e9 / static_cast<double>(edges) : 0.0);
+        std::cout << name << '\t' << numbers << '\n';
+        std::cout.flush();
+    }
+
+    // Generation cost should stay flat per edge from cache-sized meshes up to hundreds of megabytes
+    void runGeneratorBenchmark() {
+        std::cout << "generator\tvertices\tedges\tms\tns_per_edge\n";
+        for (int level = 4; level <= 10; ++level) {
+            writeGeneratorBenchmark("icosphere_" + std::to_string(level),
+                [level] { return Render::MeshGenerators::icosphere(level); });
+        }
+        for (const int size : { 64, 256, 1024, 4096 }) {
+            writeGeneratorBenchmark("grid_" + std::to_string(size),
+                [size] { return Render::MeshGenerators::grid(size, size); });
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    RunnerOptions options;
+    try {
+        options = parseArguments(argc, argv);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+
+    try {
+        if (options.benchmark) {
+            runBenchmark(options.benchmarkSizes);
+            runGeneratorBenchmark();
+            return 0;
+        }
+        int failed = runUnitTests(options.filter);
+        if (options.regression) {
+            failed += runRegression(options);
+        }
+        return failed == 0 ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "Error: %s\n", e.what());
+        return 2;
+    }
+}
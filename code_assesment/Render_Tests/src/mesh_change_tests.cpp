@@ -0,0 +1,252 @@
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include "test_harness.h"
+#include "mesh_change_log.h"
+#include "mesh_generators.h"
+#include "transformed_object_cache.h"
+#include "wireframe.h"
+
+namespace {
+    using Render::Edge;
+    using Render::Face;
+    using Render::MeshChange;
+    using Render::MeshChangeKind;
+    using Render::MeshChangeLog;
+    using Render::Vertex;
+    using Render::WireframeObject;
+
+    [[nodiscard]] std::vector<MeshChange> changesSince(const MeshChangeLog& log, uint64_t since) {
+        std::vector<MeshChange> changes;
+        if (!log.forEachSince(since, [&changes](const MeshChange& change) { changes.push_back(change); })) {
+            throw std::runtime_error("history truncated");
+        }
+        return changes;
+    }
+
+    // True when both objects hold the same vertices (bit for bit), edges and faces
+    [[nodiscard]] bool sameMesh(const WireframeObject& a, const WireframeObject& b) {
+        if (a.getVertices().size() != b.getVertices().size() || a.getEdgeCount() != b.getEdgeCount() ||
+            a.getFaces().size() != b.getFaces().size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.getVertices().size(); ++i) {
+            const auto& p = a.getVertices()[i].getPosition();
+            const auto& q = b.getVertices()[i].getPosition();
+            if (p.x != q.x || p.y != q.y || p.z != q.z) return false;
+        }
+        for (std::size_t i = 0; i < a.getEdgeCount(); ++i) {
+            if (a.getEdge(i).getVertex1Index() != b.getEdge(i).getVertex1Index() ||
+                a.getEdge(i).getVertex2Index() != b.getEdge(i).getVertex2Index()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Source drawn through 'transform' by a cache that has never seen it
+    [[nodiscard]] bool matchesFullRebuild(const Render::TransformedObjectCache& cache, const WireframeObject& source,
+        const Math::Matrix4x4& transform) {
+        Render::TransformedObjectCache fresh;
+        fresh.update(source, transform);
+        return sameMesh(cache.get(), fresh.get());
+    }
+}
+
+RENDER_TEST(changeLogMergesAdjacentAppendsAndOverlappingUpdates) {
+    MeshChangeLog log;
+    log.record(MeshChangeKind::VerticesAppended, 0, 4);
+    log.record(MeshChangeKind::VerticesAppended, 4, 6);
+    log.record(MeshChangeKind::VerticesUpdated, 1, 3);
+    log.record(MeshChangeKind::VerticesUpdated, 2, 5);
+    log.record(MeshChangeKind::VerticesUpdated, 5, 6);
+    log.record(MeshChangeKind::EdgesAppended, 0, 2);
+    RENDER_CHECK(log.getRevision() == 6);
+
+    const auto changes = changesSince(log, 0);
+    RENDER_CHECK(changes.size() == 3);
+    RENDER_CHECK(changes[0].kind == MeshChangeKind::VerticesAppended && changes[0].begin == 0 && changes[0].end == 6);
+    RENDER_CHECK(changes[1].kind == MeshChangeKind::VerticesUpdated && changes[1].begin == 1 && changes[1].end == 6);
+    RENDER_CHECK(changes[2].kind == MeshChangeKind::EdgesAppended && changes[2].revision == 6);
+}
+
+// Non-adjacent appends stay separate entries
+RENDER_TEST(changeLogKeepsGappedAppendsApart) {
+    MeshChangeLog log;
+    log.record(MeshChangeKind::EdgesAppended, 0, 2);
+    log.record(MeshChangeKind::EdgesAppended, 3, 4);
+    RENDER_CHECK(changesSince(log, 0).size() == 2);
+}
+
+RENDER_TEST(changeLogForEachSinceListsOnlyLaterChanges) {
+    MeshChangeLog log;
+    log.record(MeshChangeKind::VerticesAppended, 0, 3);
+    log.record(MeshChangeKind::EdgesAppended, 0, 3);
+    const uint64_t seen = log.getRevision();
+    log.record(MeshChangeKind::FacesAppended, 0, 1);
+
+    const auto changes = changesSince(log, seen);
+    RENDER_CHECK(changes.size() == 1);
+    RENDER_CHECK(changes[0].kind == MeshChangeKind::FacesAppended);
+    RENDER_CHECK(changesSince(log, log.getRevision()).empty());
+    RENDER_CHECK(!log.forEachSince(log.getRevision() + 1, [](const MeshChange&) {}));
+}
+
+// Past 64 unmerged entries the oldest ones are dropped and consumers that far behind must rebuild
+RENDER_TEST(changeLogDropsHistoryBeyondCapacity) {
+    MeshChangeLog log;
+    for (std::size_t i = 0; i < 64; ++i) {
+        log.record(MeshChangeKind::EdgesAppended, 2 * i, 2 * i + 1); // Gapped, so never merged
+    }
+    RENDER_CHECK(changesSince(log, 0).size() == 64);
+
+    log.record(MeshChangeKind::EdgesAppended, 200, 201);
+    int calls = 0;
+    RENDER_CHECK(!log.forEachSince(0, [&calls](const MeshChange&) { ++calls; }));
+    RENDER_CHECK(calls == 0);
+    const auto changes = changesSince(log, 1);
+    RENDER_CHECK(changes.size() == 64);
+    RENDER_CHECK(changes.front().revision == 2 && changes.back().revision == 65);
+}
+
+RENDER_TEST(changeLogCopiesAreNewMeshes) {
+    MeshChangeLog log;
+    log.record(MeshChangeKind::VerticesAppended, 0, 1);
+    const MeshChangeLog copy(log);
+    RENDER_CHECK(copy.getMeshId() != log.getMeshId());
+    RENDER_CHECK(copy.getRevision() == log.getRevision());
+
+    const uint64_t id = log.getMeshId();
+    const MeshChangeLog moved(std::move(log));
+    RENDER_CHECK(moved.getMeshId() == id);
+}
+
+RENDER_TEST(removeVerticesRenumbersEdgesAndFaces) {
+    WireframeObject object;
+    for (int i = 0; i < 5; ++i) {
+        object.addVertex(Vertex(static_cast<float>(i), 0.0f, 0.0f));
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        object.addEdge(Edge(i, i + 1));
+    }
+    object.addFace(Face(0, 3, 4));
+    object.addFace(Face(0, 1, 4));
+
+    object.removeVertices(1, 2);
+    RENDER_CHECK(object.getVertices().size() == 3);
+    RENDER_CHECK(object.getVertices()[1].getPosition().x == 3.0f);
+    RENDER_CHECK(object.getEdgeCount() == 1);
+    RENDER_CHECK(object.getEdge(0).getVertex1Index() == 1 && object.getEdge(0).getVertex2Index() == 2);
+    RENDER_CHECK(object.getFaces().size() == 1);
+    RENDER_CHECK(object.getFaces()[0].getVertex2Index() == 1 && object.getFaces()[0].getVertex3Index() == 2);
+    RENDER_CHECK(object.hasValidEdgeIndices());
+}
+
+RENDER_TEST(removeVerticesOutOfRangeLeavesObjectUnchanged) {
+    WireframeObject object;
+    object.addVertex(Vertex(0.0f, 0.0f, 0.0f));
+    object.addVertex(Vertex(1.0f, 0.0f, 0.0f));
+    object.addEdge(Edge(0, 1));
+    const uint64_t revision = object.getRevision();
+
+    bool threw = false;
+    try {
+        object.removeVertices(1, 2);
+    }
+    catch (const std::out_of_range&) {
+        threw = true;
+    }
+    RENDER_CHECK(threw);
+    RENDER_CHECK(object.getVertices().size() == 2 && object.getEdgeCount() == 1);
+    RENDER_CHECK(object.getRevision() == revision);
+}
+
+// An index of SIZE_MAX has no "one past" limit; it used to wrap to zero and pick 16-bit storage
+RENDER_TEST(edgesWithMaximumIndexAreRejected) {
+    constexpr std::size_t maxIndex = (std::numeric_limits<std::size_t>::max)();
+    WireframeObject object;
+    object.addVertex(Vertex(0.0f, 0.0f, 0.0f));
+
+    bool addThrew = false;
+    try {
+        object.addEdge(Edge(0, maxIndex));
+    }
+    catch (const std::out_of_range&) {
+        addThrew = true;
+    }
+    const Edge batch[] = { Edge(0, 0), Edge(maxIndex, 0) };
+    bool appendThrew = false;
+    try {
+        (void)object.appendEdges(batch);
+    }
+    catch (const std::out_of_range&) {
+        appendThrew = true;
+    }
+    RENDER_CHECK(addThrew && appendThrew);
+    RENDER_CHECK(object.getEdgeCount() == 0);
+}
+
+RENDER_TEST(transformedCacheFollowsIncrementalEdits) {
+    auto source = Render::MeshGenerators::icosphere(2, 1.0f, false);
+    const Math::Matrix4x4 transform =
+        Math::Matrix4x4::createTranslation(0.5f, -1.0f, 2.0f) * Math::Matrix4x4::createRotationY(0.7f);
+    Render::TransformedObjectCache cache;
+    cache.update(*source, transform);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, transform));
+
+    // Appended vertices and edges
+    const std::size_t base = source->getVertices().size();
+    const Vertex added[] = { Vertex(2.0f, 0.0f, 0.0f), Vertex(0.0f, 2.0f, 0.0f) };
+    (void)source->appendVertices(added);
+    const Edge addedEdges[] = { Edge(base, base + 1), Edge(0, base) };
+    (void)source->appendEdges(addedEdges);
+    cache.update(*source, transform);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, transform));
+
+    // Moved vertices, in two overlapping batches
+    const Math::Vector3D moved[] = { Math::Vector3D(0.1f, 0.2f, 0.3f), Math::Vector3D(-0.4f, 0.5f, 0.6f) };
+    source->updateVertices(3, moved);
+    source->updateVertices(4, moved);
+    cache.update(*source, transform);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, transform));
+
+    // A new matrix on an unchanged mesh
+    const Math::Matrix4x4 turned = Math::Matrix4x4::createRotationX(0.3f) * transform;
+    cache.update(*source, turned);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, turned));
+
+    // Removals fall back to a rebuild
+    source->removeVertices(0, 5);
+    cache.update(*source, turned);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, turned));
+}
+
+// A consumer further behind than the log's history must still end up exact
+RENDER_TEST(transformedCacheRebuildsAfterTruncatedHistory) {
+    auto source = Render::MeshGenerators::grid(8, 8, 2.0f, false);
+    const Math::Matrix4x4 transform = Math::Matrix4x4::createScale(2.0f, 0.5f, 1.0f);
+    Render::TransformedObjectCache cache;
+    cache.update(*source, transform);
+
+    for (std::size_t i = 0; i < 70; ++i) {
+        const Math::Vector3D position(static_cast<float>(i), 1.0f, 0.0f);
+        source->updateVertices((i * 2) % source->getVertices().size(), std::span(&position, 1)); // Gapped, never merged
+    }
+    cache.update(*source, transform);
+    RENDER_CHECK(matchesFullRebuild(cache, *source, transform));
+}
+
+// Limits are one past the largest index, so 65536 still fits 16-bit indices and 2^32 fits 32-bit ones
+RENDER_TEST(narrowestIndexWidthBoundaries) {
+    using EdgeIndexWidth = WireframeObject::EdgeIndexWidth;
+    RENDER_CHECK(WireframeObject::narrowestIndexWidth(0) == EdgeIndexWidth::Bits16);
+    RENDER_CHECK(WireframeObject::narrowestIndexWidth(65536) == EdgeIndexWidth::Bits16);
+    RENDER_CHECK(WireframeObject::narrowestIndexWidth(65537) == EdgeIndexWidth::Bits32);
+    // With a 32-bit size_t this is the largest limit there is, and must not fall back to 16 bits
+    RENDER_CHECK(WireframeObject::narrowestIndexWidth((std::numeric_limits<uint32_t>::max)()) == EdgeIndexWidth::Bits32);
+    if constexpr (sizeof(std::size_t) > sizeof(uint32_t)) {
+        RENDER_CHECK(WireframeObject::narrowestIndexWidth(std::size_t{ 1 } << 32) == EdgeIndexWidth::Bits32);
+        RENDER_CHECK(WireframeObject::narrowestIndexWidth((std::size_t{ 1 } << 32) + 1) == EdgeIndexWidth::BitsWide);
+    }
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <utility>
+#include "test_harness.h"
+#include "mesh_generators.h"
+
+namespace {
+    using Render::WireframeObject;
+    using EdgeKey = std::pair<std::size_t, std::size_t>;
+
+    [[nodiscard]] EdgeKey edgeKey(std::size_t a, std::size_t b) noexcept {
+        return { std::min(a, b), std::max(a, b) };
+    }
+
+    // Every edge joins two different, existing vertices and no edge is listed twice (in either direction)
+    [[nodiscard]] bool edgesAreValidAndUnique(const WireframeObject& object) {
+        const std::size_t vertexCount = object.getVertices().size();
+        std::set<EdgeKey> seen;
+        for (std::size_t i = 0; i < object.getEdgeCount(); ++i) {
+            const auto edge = object.getEdge(i);
+            const std::size_t a = edge.getVertex1Index();
+            const std::size_t b = edge.getVertex2Index();
+            if (a >= vertexCount || b >= vertexCount || a == b) return false;
+            if (!seen.insert(edgeKey(a, b)).second) return false;
+        }
+        return true;
+    }
+
+    // How many faces use each side; empty when a face is degenerate or out of range
+    [[nodiscard]] std::map<EdgeKey, int> faceSideCounts(const WireframeObject& object) {
+        const std::size_t vertexCount = object.getVertices().size();
+        std::map<EdgeKey, int> counts;
+        for (const auto& face : object.getFaces()) {
+            const std::size_t v[3] = { face.getVertex1Index(), face.getVertex2Index(), face.getVertex3Index() };
+            for (int i = 0; i < 3; ++i) {
+                const std::size_t a = v[i];
+                const std::size_t b = v[(i + 1) % 3];
+                if (a >= vertexCount || b >= vertexCount || a == b) return {};
+                ++counts[edgeKey(a, b)];
+            }
+        }
+        return counts;
+    }
+
+    // Every drawn edge is a side of some face
+    [[nodiscard]] bool edgesLieOnFaces(const WireframeObject& object, const std::map<EdgeKey, int>& sides) {
+        for (std::size_t i = 0; i < object.getEdgeCount(); ++i) {
+            const auto edge = object.getEdge(i);
+            if (sides.find(edgeKey(edge.getVertex1Index(), edge.getVertex2Index())) == sides.end()) return false;
+        }
+        return true;
+    }
+
+    // V - E + F of the triangulated surface
+    [[nodiscard]] int64_t eulerCharacteristic(const WireframeObject& object, const std::map<EdgeKey, int>& sides) noexcept {
+        return static_cast<int64_t>(object.getVertices().size()) - static_cast<int64_t>(sides.size()) +
+            static_cast<int64_t>(object.getFaces().size());
+    }
+
+    // A closed surface: every face side is shared by exactly two faces
+    [[nodiscard]] bool isClosed(const std::map<EdgeKey, int>& sides) {
+        return !sides.empty() && std::all_of(sides.begin(), sides.end(), [](const auto& side) { return side.second == 2; });
+    }
+
+    // Closed, edges valid and on the surface, and V - E + F == 'euler'
+    [[nodiscard]] bool isClosedSurface(const WireframeObject& object, int64_t euler) {
+        const auto sides = faceSideCounts(object);
+        return edgesAreValidAndUnique(object) && isClosed(sides) && edgesLieOnFaces(object, sides) &&
+            eulerCharacteristic(object, sides) == euler;
+    }
+}
+
+RENDER_TEST(icosphereLevelsAreClosedSpheres) {
+    for (int level = 0; level <= 5; ++level) {
+        const auto mesh = Render::MeshGenerators::icosphere(level, 1.0f, true);
+        const std::size_t n = std::size_t{ 1 } << level;
+        RENDER_CHECK(mesh->getVertices().size() == 10 * n * n + 2);
+        RENDER_CHECK(mesh->getEdgeCount() == 30 * n * n);
+        RENDER_CHECK(mesh->getFaces().size() == 20 * n * n);
+        RENDER_CHECK(isClosedSurface(*mesh, 2));
+
+        // Subdivision draws exactly the triangle sides, nothing more
+        RENDER_CHECK(faceSideCounts(*mesh).size() == mesh->getEdgeCount());
+    }
+}
+
+RENDER_TEST(uvSphereIsClosedSphere) {
+    for (const auto& [rings, segments] : { std::pair{ 2, 3 }, std::pair{ 7, 12 }, std::pair{ 32, 64 } }) {
+        const auto mesh = Render::MeshGenerators::uvSphere(rings, segments, 1.0f, true);
+        RENDER_CHECK(mesh->getVertices().size() == static_cast<std::size_t>((rings - 1) * segments + 2));
+        RENDER_CHECK(mesh->getEdgeCount() == static_cast<std::size_t>((2 * rings - 1) * segments));
+        RENDER_CHECK(isClosedSurface(*mesh, 2));
+    }
+}
+
+RENDER_TEST(torusIsClosedWithGenusOne) {
+    for (const auto& [rings, sides] : { std::pair{ 3, 3 }, std::pair{ 24, 12 } }) {
+        const auto mesh = Render::MeshGenerators::torus(rings, sides, 1.0f, 0.35f, true);
+        RENDER_CHECK(mesh->getVertices().size() == static_cast<std::size_t>(rings * sides));
+        RENDER_CHECK(mesh->getEdgeCount() == static_cast<std::size_t>(2 * rings * sides));
+        RENDER_CHECK(isClosedSurface(*mesh, 0));
+    }
+}
+
+// An open sheet: boundary sides belong to one face, inner ones to two, and V - E + F == 1
+RENDER_TEST(gridIsOneOpenSheet) {
+    for (const auto& [columns, rows] : { std::pair{ 1, 1 }, std::pair{ 5, 3 }, std::pair{ 40, 40 } }) {
+        const auto mesh = Render::MeshGenerators::grid(columns, rows, 2.0f, true);
+        RENDER_CHECK(edgesAreValidAndUnique(*mesh));
+        const auto sides = faceSideCounts(*mesh);
+        RENDER_CHECK(edgesLieOnFaces(*mesh, sides));
+        RENDER_CHECK(eulerCharacteristic(*mesh, sides) == 1);
+
+        std::size_t boundary = 0;
+        bool sharedAtMostTwice = !sides.empty();
+        for (const auto& side : sides) {
+            if (side.second == 1) ++boundary;
+            sharedAtMostTwice = sharedAtMostTwice && side.second <= 2;
+        }
+        RENDER_CHECK(sharedAtMostTwice);
+        RENDER_CHECK(boundary == static_cast<std::size_t>(2 * (columns + rows)));
+    }
+}
+
+// Faces are optional and must not change the drawn edges
+RENDER_TEST(generatorsWithoutFacesDrawTheSameEdges) {
+    const auto withFaces = Render::MeshGenerators::icosphere(3, 1.0f, true);
+    const auto without = Render::MeshGenerators::icosphere(3, 1.0f, false);
+    RENDER_CHECK(without->getFaces().empty());
+    RENDER_CHECK(edgesAreValidAndUnique(*without));
+    bool same = withFaces->getEdgeCount() == without->getEdgeCount();
+    for (std::size_t i = 0; same && i < without->getEdgeCount(); ++i) {
+        same = withFaces->getEdge(i).getVertex1Index() == without->getEdge(i).getVertex1Index() &&
+            withFaces->getEdge(i).getVertex2Index() == without->getEdge(i).getVertex2Index();
+    }
+    RENDER_CHECK(same);
+}
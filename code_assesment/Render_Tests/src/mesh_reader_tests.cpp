@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "test_harness.h"
+#include "object_loader.h"
+
+namespace {
+    // Writes 'contents' to a file in the temp directory and removes it again on destruction
+    class TempFile {
+    private:
+        std::filesystem::path path;
+
+    public:
+        TempFile(const std::string& name, const std::string& contents)
+            : path(std::filesystem::temp_directory_path() / name) {
+            std::ofstream file(path, std::ios::binary);
+            file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        }
+
+        ~TempFile() {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        [[nodiscard]] std::string string() const {
+            return path.string();
+        }
+    };
+
+    template <typename T>
+    void appendLittleEndian(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T)); // Test hosts are little-endian
+    }
+
+    // Binary PLY with three vertices and one face whose list length is 'listCount'
+    [[nodiscard]] std::string plyTriangle(uint64_t faceCount, uint32_t listCount) {
+        std::string ply = "ply\nformat binary_little_endian 1.0\nelement vertex 3\n"
+            "property float x\nproperty float y\nproperty float z\n"
+            "element face " + std::to_string(faceCount) + "\nproperty list uint32 uint32 vertex_indices\nend_header\n";
+        const float vertices[] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+        for (const float v : vertices) appendLittleEndian(ply, v);
+        appendLittleEndian(ply, listCount);
+        for (uint32_t i = 0; i < 3; ++i) appendLittleEndian(ply, i);
+        return ply;
+    }
+
+    [[nodiscard]] bool loadThrows(const std::string& filename) {
+        try {
+            (void)Render::ObjectLoader().loadFromFile(filename);
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+RENDER_TEST(plyTriangleLoads) {
+    const TempFile file("render_tests_valid.ply", plyTriangle(1, 3));
+    const auto object = Render::ObjectLoader().loadFromFile(file.string());
+    RENDER_CHECK(object->getVertices().size() == 3);
+    RENDER_CHECK(object->getEdgeCount() == 3);
+}
+
+// A list length near 2^32 must be rejected, not turned into a multi-gigabyte read
+RENDER_TEST(plyListLengthBeyondFileIsRejected) {
+    const TempFile file("render_tests_list.ply", plyTriangle(1, 0xFFFFFFFFu));
+    RENDER_CHECK(loadThrows(file.string()));
+}
+
+RENDER_TEST(plyElementCountBeyondFileIsRejected) {
+    const TempFile file("render_tests_count.ply", plyTriangle(uint64_t{ 1 } << 40, 3));
+    RENDER_CHECK(loadThrows(file.string()));
+}
+
+RENDER_TEST(csvHeaderCountsBeyondFileAreRejected) {
+    const TempFile file("render_tests_counts.csv", "2000000000,2000000000\n1,0,0,0\n2,1,0,0\n3,0,1,0\n1,2,3\n");
+    RENDER_CHECK(loadThrows(file.string()));
+}
+
+RENDER_TEST(csvTriangleLoads) {
+    const TempFile file("render_tests_valid.csv", "3,1\n1,0,0,0\n2,1,0,0\n3,0,1,0\n1,2,3");
+    const auto object = Render::ObjectLoader().loadFromFile(file.string());
+    RENDER_CHECK(object->getVertices().size() == 3);
+    RENDER_CHECK(object->getEdgeCount() == 3);
+}
+
+// Progress counts the bytes actually read, so CRLF and unterminated files both end at their size
+RENDER_TEST(csvProgressEndsAtFileSize) {
+    const std::string lf = "3,1\n1,0,0,0\n2,1,0,0\n3,0,1,0\n1,2,3\n";
+    const std::string crlf = "3,1\r\n1,0,0,0\r\n2,1,0,0\r\n3,0,1,0\r\n1,2,3\r\n";
+    const std::string unterminated = "3,1\r\n1,0,0,0\r\n2,1,0,0\r\n3,0,1,0\r\n1,2,3";
+    for (const std::string* contents : { &lf, &crlf, &unterminated }) {
+        const TempFile file("render_tests_progress.csv", *contents);
+        Render::LoadControl control;
+        const auto object = Render::ObjectLoader().loadFromCSV(file.string(), &control);
+        RENDER_CHECK(object->getVertices().size() == 3);
+        const auto progress = control.getProgress();
+        RENDER_CHECK(progress.bytesRead == contents->size() && progress.totalBytes == contents->size());
+    }
+}
@@ -0,0 +1,24 @@
+#include <atomic>
+#include <stdexcept>
+#include "test_harness.h"
+#include "parallel_for.h"
+
+// A throwing chunk reaches the caller, and only after the other chunks have run to completion
+RENDER_TEST(parallelChunksRethrowsAfterEveryChunkFinishes) {
+    constexpr size_t Count = 64;
+    std::atomic<size_t> finished{ 0 };
+    bool caught = false;
+    try {
+        Render::parallelChunks(Count, 1, [&](size_t chunk, size_t begin, size_t end) {
+            if (chunk == 0) throw std::runtime_error("chunk failed");
+            finished.fetch_add(end - begin);
+        });
+    }
+    catch (const std::runtime_error&) {
+        caught = true;
+    }
+    RENDER_CHECK(caught);
+    // Chunk 0 covers the first ceil(Count / chunks) items
+    const size_t chunks = Render::parallelChunkCount(Count, 1);
+    RENDER_CHECK(finished.load() == Count - (Count + chunks - 1) / chunks);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdio>
+#include <vector>
+
+// Minimal self-registering test harness. A test is a function taking a TestContext; failed checks
+// are reported and counted, and the test carries on so one run shows every failure.
+namespace Tests {
+    class TestContext {
+    private:
+        int failures = 0;
+
+    public:
+        void check(bool passed, const char* expression, const char* file, int line) noexcept {
+            if (!passed) {
+                ++failures;
+                std::fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+            }
+        }
+
+        [[nodiscard]] int getFailures() const noexcept {
+            return failures;
+        }
+    };
+
+    struct TestCase {
+        const char* name;
+        void (*run)(TestContext&);
+    };
+
+    // Filled during static initialization by RENDER_TEST
+    [[nodiscard]] inline std::vector<TestCase>& registry() {
+        static std::vector<TestCase> tests;
+        return tests;
+    }
+
+    struct TestRegistrar {
+        TestRegistrar(const char* name, void (*run)(TestContext&)) {
+            registry().push_back(TestCase{ name, run });
+        }
+    };
+}
+
+#define RENDER_TEST(name) \
+    static void name(Tests::TestContext& context); \
+    static const Tests::TestRegistrar name##Registrar(#name, name); \
+    static void name(Tests::TestContext& context)
+
+#define RENDER_CHECK(expression) context.check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "test_harness.h"
+#include "video_stream_sink.h"
+
+namespace {
+    // Straightforward per-pixel conversion with the same integer formulas
+    void referenceYUV420(const std::vector<Render::Color>& pixels, int width, int height,
+        std::vector<uint8_t>& y, std::vector<uint8_t>& u, std::vector<uint8_t>& v) {
+        const auto clampByte = [](int value) { return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value)); };
+        const int chromaWidth = (width + 1) / 2;
+        const int chromaHeight = (height + 1) / 2;
+        y.resize(static_cast<size_t>(width) * height);
+        u.resize(static_cast<size_t>(chromaWidth) * chromaHeight);
+        v.resize(u.size());
+        for (size_t i = 0; i < y.size(); ++i) {
+            const Render::Color& c = pixels[i];
+            y[i] = static_cast<uint8_t>((77 * c.r + 150 * c.g + 29 * c.b + 128) >> 8);
+        }
+        for (int cy = 0; cy < chromaHeight; ++cy) {
+            for (int cx = 0; cx < chromaWidth; ++cx) {
+                int r = 0, g = 0, b = 0;
+                for (int dy = 0; dy < 2; ++dy) {
+                    for (int dx = 0; dx < 2; ++dx) {
+                        // Edge blocks repeat the last row or column
+                        const int px = std::min(2 * cx + dx, width - 1);
+                        const int py = std::min(2 * cy + dy, height - 1);
+                        const Render::Color& c = pixels[static_cast<size_t>(py) * width + px];
+                        r += c.r;
+                        g += c.g;
+                        b += c.b;
+                    }
+                }
+                const size_t index = static_cast<size_t>(cy) * chromaWidth + cx;
+                u[index] = clampByte(((-43 * r - 85 * g + 128 * b + 512) >> 10) + 128);
+                v[index] = clampByte(((128 * r - 107 * g - 21 * b + 512) >> 10) + 128);
+            }
+        }
+    }
+}
+
+// The vectorized path handles 32 pixels at a time; sizes around that exercise it and the scalar tails
+RENDER_TEST(rgbToYUV420MatchesScalarReference) {
+    uint32_t state = 12345;
+    const auto next = [&state] {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<uint8_t>(state >> 24);
+    };
+
+    const int widths[] = { 1, 2, 7, 31, 32, 33, 63, 64, 95, 130 };
+    const int heights[] = { 1, 2, 3, 8, 9 };
+    for (const int width : widths) {
+        for (const int height : heights) {
+            std::vector<Render::Color> pixels(static_cast<size_t>(width) * height);
+            for (auto& pixel : pixels) {
+                pixel = Render::Color(next(), next(), next());
+            }
+            // Saturated corners reach the clamps
+            pixels.front() = Render::Color(255, 0, 0);
+            pixels.back() = Render::Color(0, 0, 255);
+
+            std::vector<uint8_t> expectedY, expectedU, expectedV;
+            referenceYUV420(pixels, width, height, expectedY, expectedU, expectedV);
+
+            std::vector<uint8_t> y(expectedY.size()), u(expectedU.size()), v(expectedV.size());
+            Render::VideoConvert::rgbToYUV420(pixels.data(), width, height, y.data(), u.data(), v.data());
+            RENDER_CHECK(y == expectedY);
+            RENDER_CHECK(u == expectedU);
+            RENDER_CHECK(v == expectedV);
+        }
+    }
+}